@@ -0,0 +1,238 @@
+// --- Host Backend: Arduino Core ---
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "HostSim.h"
+
+// --- Digital / Analog I/O ---
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < HostSim::NUM_PINS) hostSim().modes[pin] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < HostSim::NUM_PINS) hostSim().digital[pin] = val ? HIGH : LOW;
+    hostSim().advance(kPinWriteNs);
+}
+
+int digitalRead(uint8_t pin) {
+    HostSim& sim = hostSim();
+    sim.pinReads++;
+    sim.advance(kDigitalReadNs);
+    return (pin < HostSim::NUM_PINS) ? sim.digital[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+    HostSim& sim = hostSim();
+    sim.analogReads++;
+    sim.advance(kAnalogReadNs);
+    if (pin < 14) pin += 14; // analogRead(5) == analogRead(A5)
+    return (pin < HostSim::NUM_PINS) ? sim.analogSample(pin) : 0;
+}
+
+// --- Tone ---
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+    HostSim& sim = hostSim();
+    sim.advance(kToneNs);
+    sim.buzzer.start(sim.nowNs(), pin, frequency);
+    if (duration > 0) {
+        sim.scheduleToneStop(sim.nowNs() + (uint64_t)duration * 1000000ULL, pin);
+    }
+}
+
+void noTone(uint8_t pin) {
+    HostSim& sim = hostSim();
+    sim.advance(kToneNs);
+    sim.buzzer.stop(sim.nowNs(), pin);
+}
+
+// --- Time ---
+// Truncated to 32 bits like the board's millis()/micros() counters
+
+unsigned long millis() {
+    return (uint32_t)(hostSim().nowNs() / 1000000ULL);
+}
+
+unsigned long micros() {
+    return (uint32_t)(hostSim().nowNs() / 1000ULL);
+}
+
+void delay(unsigned long ms) {
+    hostSim().advance((uint64_t)ms * 1000000ULL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostSim().advance((uint64_t)us * 1000ULL);
+}
+
+// --- Interrupts ---
+
+void noInterrupts() {
+    hostSim().setInterrupts(false);
+}
+
+void interrupts() {
+    hostSim().setInterrupts(true);
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+    if (pin != 2 && pin != 3) return; // No IRQ line on this pin
+    hostSim().attachPinInterrupt(pin, isr, mode);
+}
+
+void detachInterrupt(uint8_t pin) {
+    hostSim().attachPinInterrupt(pin, NULL, 0);
+}
+
+// --- Math ---
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Deterministic LCG so scripted runs are reproducible
+static unsigned long randState = 1;
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) randState = seed;
+}
+
+long random(long howBig) {
+    if (howBig == 0) return 0;
+    randState = randState * 1103515245UL + 12345UL;
+    return (long)((randState >> 16) & 0x7FFF) % howBig;
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return random(howBig - howSmall) + howSmall;
+}
+
+// --- String ---
+
+static unsigned long stringAllocations = 0;
+
+String::String(const char* s) : str(s ? s : "") { if (!str.empty()) stringAllocations++; }
+String::String(const std::string& s) : str(s) { if (!str.empty()) stringAllocations++; }
+String::String(char c) : str(1, c) { stringAllocations++; }
+String::String(int value) : str(std::to_string(value)) { stringAllocations++; }
+String::String(unsigned int value) : str(std::to_string(value)) { stringAllocations++; }
+String::String(long value) : str(std::to_string(value)) { stringAllocations++; }
+String::String(unsigned long value) : str(std::to_string(value)) { stringAllocations++; }
+String::String(const String& other) : str(other.str) { if (!str.empty()) stringAllocations++; }
+
+String& String::operator=(const String& other) {
+    if (this != &other) {
+        str = other.str;
+        if (!str.empty()) stringAllocations++;
+    }
+    return *this;
+}
+
+String String::substring(unsigned int from) const {
+    return substring(from, length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (to > length()) to = length();
+    if (from >= to) return String();
+    return String(str.substr(from, to - from));
+}
+
+String& String::operator+=(const String& rhs) {
+    str += rhs.str;
+    stringAllocations++;
+    return *this;
+}
+
+String operator+(const String& lhs, const String& rhs) {
+    String out(lhs);
+    out += rhs;
+    return out;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+    return lhs + String(rhs);
+}
+
+String operator+(const char* lhs, const String& rhs) {
+    return String(lhs) + rhs;
+}
+
+unsigned long String::allocations() {
+    return stringAllocations;
+}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    return str ? write((const uint8_t*)str, strlen(str)) : 0;
+}
+
+size_t Print::print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+size_t Print::print(const String& s) { return write(s.c_str()); }
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base) { return printNumber(n, base); }
+size_t Print::print(unsigned int n, int base) { return printNumber(n, base); }
+size_t Print::print(unsigned long n, int base) { return printNumber(n, base); }
+size_t Print::print(int n, int base) { return print((long)n, base); }
+
+size_t Print::print(long n, int base) {
+    if (base == DEC && n < 0) {
+        return write('-') + printNumber((unsigned long)(-n), DEC);
+    }
+    return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+size_t Print::printNumber(unsigned long n, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    if (base < 2) base = 10;
+    do {
+        int digit = (int)(n % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        n /= base;
+    } while (n);
+    return write(p);
+}
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const __FlashStringHelper* str) { return print(str) + println(); }
+size_t Print::println(const String& s) { return print(s) + println(); }
+size_t Print::println(const char* str) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+size_t Print::println(double n, int digits) { return print(n, digits) + println(); }
+
+// --- Serial (stdout) ---
+
+HostSerial Serial;
+
+size_t HostSerial::write(uint8_t c) {
+    if (c != '\r') fputc(c, stdout);
+    return 1;
+}
+
+void HostSerial::flush() {
+    fflush(stdout);
+}
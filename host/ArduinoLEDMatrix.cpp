@@ -0,0 +1,33 @@
+// --- Host Backend: ArduinoLEDMatrix ---
+
+#include <Arduino_LED_Matrix.h>
+
+#include "HostSim.h"
+
+void ArduinoLEDMatrix::begin() {
+    hostSim().matrix.begins++;
+}
+
+void ArduinoLEDMatrix::clear() {
+    const uint32_t blank[3] = { 0, 0, 0 };
+    loadFrame(blank);
+}
+
+void ArduinoLEDMatrix::loadFrame(const uint32_t buffer[3]) {
+    HostSim& sim = hostSim();
+    sim.matrix.load(buffer);
+    sim.matrix.busNs += kMatrixFrameNs;
+    sim.advance(kMatrixFrameNs);
+}
+
+// Packs one byte per pixel (row-major, non-zero = on) into frame words
+void ArduinoLEDMatrix::loadPixels(uint8_t* arr, size_t size) {
+    uint32_t frame[3] = { 0, 0, 0 };
+    for (size_t i = 0; i < size && i < 96; i++) {
+        if (arr[i]) frame[i / 32] |= 1UL << (31 - (i % 32));
+    }
+    HostSim& sim = hostSim();
+    sim.matrix.busNs += size * kMatrixPixelNs;
+    sim.advance(size * kMatrixPixelNs);
+    loadFrame(frame);
+}
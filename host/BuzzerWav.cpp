@@ -0,0 +1,59 @@
+#include "BuzzerWav.h"
+
+#include <stdio.h>
+
+static const int16_t kAmplitude = 8000;
+
+static void put16(FILE* f, uint16_t v) {
+    fputc(v & 0xFF, f);
+    fputc(v >> 8, f);
+}
+
+static void put32(FILE* f, uint32_t v) {
+    put16(f, v & 0xFFFF);
+    put16(f, v >> 16);
+}
+
+bool writeBuzzerWav(const char* path, const BuzzerModel& buzzer, uint64_t endNs, unsigned sampleRate) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    uint32_t samples = (uint32_t)(endNs * sampleRate / 1000000000ULL);
+    uint32_t dataBytes = samples * 2;
+
+    // RIFF header, PCM, 1 channel, 16 bit
+    fwrite("RIFF", 1, 4, f);
+    put32(f, 36 + dataBytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(f, 16);
+    put16(f, 1);
+    put16(f, 1);
+    put32(f, sampleRate);
+    put32(f, sampleRate * 2);
+    put16(f, 2);
+    put16(f, 16);
+    fwrite("data", 1, 4, f);
+    put32(f, dataBytes);
+
+    size_t next = 0;
+    unsigned int frequency = 0;
+    double phase = 0;
+    for (uint32_t i = 0; i < samples; i++) {
+        uint64_t t = (uint64_t)i * 1000000000ULL / sampleRate;
+        while (next < buzzer.events.size() && buzzer.events[next].timeNs <= t) {
+            frequency = buzzer.events[next].frequency;
+            next++;
+        }
+
+        int16_t sample = 0;
+        if (frequency > 0) {
+            phase += (double)frequency / sampleRate;
+            phase -= (int)phase;
+            sample = phase < 0.5 ? kAmplitude : -kAmplitude;
+        }
+        put16(f, (uint16_t)sample);
+    }
+
+    fclose(f);
+    return true;
+}
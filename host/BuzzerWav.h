@@ -0,0 +1,15 @@
+#ifndef BUZZER_WAV_H
+#define BUZZER_WAV_H
+
+// --- Offline Buzzer Synth ---
+// Renders the buzzer model's tone()/noTone() timeline as the square wave the
+// piezo would get, into a mono 16-bit PCM WAV file. Phase runs on across
+// pitch changes, like the tone() timer output.
+
+#include <stdint.h>
+
+#include "HostSim.h"
+
+bool writeBuzzerWav(const char* path, const BuzzerModel& buzzer, uint64_t endNs, unsigned sampleRate = 22050);
+
+#endif // BUZZER_WAV_H
@@ -0,0 +1,63 @@
+// --- Host Backend: FspTimer ---
+
+#include <FspTimer.h>
+
+#include "HostSim.h"
+
+// The RA4M1 has 8 GPT + 2 AGT channels; the LED matrix and tone() take some
+static int timersHandedOut = 0;
+static const int kFreeTimers = 4;
+
+FspTimer::FspTimer() : id(-1), frequency(0), callback(nullptr), context(nullptr) {}
+
+int8_t FspTimer::get_available_timer(uint8_t& type, bool force) {
+    (void)force;
+    if (timersHandedOut >= kFreeTimers) return -1;
+    type = GPT_TIMER;
+    return (int8_t)(timersHandedOut++);
+}
+
+bool FspTimer::begin(timer_mode_t mode, uint8_t type, uint8_t channel, float freq_hz, float duty_perc,
+                     GPTimerCbk_f cbk, void* ctx) {
+    (void)type;
+    (void)channel;
+    (void)duty_perc;
+    if (mode != TIMER_MODE_PERIODIC || freq_hz <= 0) return false;
+    frequency = freq_hz;
+    callback = cbk;
+    context = ctx;
+    return true;
+}
+
+bool FspTimer::setup_overflow_irq(uint8_t priority, void (*isr_fnc)()) {
+    (void)priority;
+    (void)isr_fnc;
+    return callback != nullptr;
+}
+
+bool FspTimer::open() {
+    if (frequency <= 0) return false;
+    if (id < 0) id = hostSim().addTimer((uint64_t)(1e9 / frequency + 0.5), fire, this);
+    return true;
+}
+
+bool FspTimer::start() {
+    if (id < 0) return false;
+    hostSim().startTimer(id);
+    return true;
+}
+
+bool FspTimer::stop() {
+    hostSim().stopTimer(id);
+    return true;
+}
+
+void FspTimer::end() {
+    stop();
+}
+
+void FspTimer::fire(void* self) {
+    FspTimer* timer = static_cast<FspTimer*>(self);
+    timer_callback_args_t args = { TIMER_EVENT_CYCLE_END, 0, timer->context };
+    timer->callback(&args);
+}
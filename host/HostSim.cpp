@@ -0,0 +1,428 @@
+#include "HostSim.h"
+
+#include <Arduino.h>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+HostSim& hostSim() {
+    static HostSim sim;
+    return sim;
+}
+
+// --- HD44780 Controller Model ---
+
+Hd44780Model::Hd44780Model() {
+    reset();
+    commands = 0;
+    dataBytes = 0;
+    clears = 0;
+    homes = 0;
+    busNs = 0;
+}
+
+void Hd44780Model::reset() {
+    memset(ddram, ' ', sizeof(ddram));
+    memset(cgram, 0, sizeof(cgram));
+    address = 0;
+    cgramMode = false;
+    increment = true;
+    shiftOnWrite = false;
+    displayShift = 0;
+}
+
+void Hd44780Model::moveAddress(int step) {
+    if (cgramMode) {
+        address = (address + step) & 0x3F;
+        return;
+    }
+    // Two-line mode: 0x00-0x27 and 0x40-0x67 form one 80-byte ring
+    if (step > 0) {
+        if (address == 0x27) address = 0x40;
+        else if (address == 0x67) address = 0x00;
+        else address++;
+    } else {
+        if (address == 0x00) address = 0x67;
+        else if (address == 0x40) address = 0x27;
+        else address--;
+    }
+}
+
+void Hd44780Model::command(uint8_t value) {
+    if (value & 0x80) {
+        // Set DDRAM address
+        cgramMode = false;
+        address = value & 0x7F;
+        if (address >= DDRAM_SIZE || (address >= 0x28 && address < 0x40)) address = 0;
+    } else if (value & 0x40) {
+        // Set CGRAM address
+        cgramMode = true;
+        address = value & 0x3F;
+    } else if (value & 0x20) {
+        // Function set: 4-bit, 2-line, 5x8 assumed
+    } else if (value & 0x10) {
+        // Cursor / display shift
+        int dir = (value & 0x04) ? 1 : -1;
+        if (value & 0x08) {
+            // Moving the display left means the window slides right in DDRAM
+            displayShift = (displayShift - dir + ROW_LENGTH) % ROW_LENGTH;
+        } else {
+            moveAddress(dir);
+        }
+    } else if (value & 0x08) {
+        // Display on/off control: no effect on memory
+    } else if (value & 0x04) {
+        increment = (value & 0x02) != 0;
+        shiftOnWrite = (value & 0x01) != 0;
+    } else if (value & 0x02) {
+        homes++;
+        cgramMode = false;
+        address = 0;
+        displayShift = 0;
+    } else if (value & 0x01) {
+        clears++;
+        memset(ddram, ' ', sizeof(ddram));
+        cgramMode = false;
+        address = 0;
+        increment = true;
+        displayShift = 0;
+    }
+}
+
+void Hd44780Model::send(uint8_t value, bool isData) {
+    uint64_t cost = kLcdByteNs;
+
+    if (isData) {
+        dataBytes++;
+        if (cgramMode) {
+            cgram[address & 0x3F] = value & 0x1F;
+        } else {
+            ddram[address] = value;
+            if (shiftOnWrite) {
+                displayShift = (displayShift + (increment ? 1 : -1) + ROW_LENGTH) % ROW_LENGTH;
+            }
+        }
+        moveAddress(increment ? 1 : -1);
+    } else {
+        commands++;
+        command(value);
+        // Clear display (0x01) and return home (0x02/0x03) are the slow ones
+        if (value == 0x01 || (value & 0xFE) == 0x02) cost += kLcdClearHomeNs;
+    }
+
+    busNs += cost;
+    hostSim().advance(cost);
+}
+
+uint8_t Hd44780Model::visibleAt(int col, int row) const {
+    int base = (row == 0) ? 0x00 : 0x40;
+    return ddram[base + (col + displayShift) % ROW_LENGTH];
+}
+
+void Hd44780Model::printScreen(FILE* out) const {
+    fprintf(out, "+----------------+\n");
+    for (int row = 0; row < 2; row++) {
+        fputc('|', out);
+        for (int col = 0; col < 16; col++) {
+            uint8_t c = visibleAt(col, row);
+            // CGRAM glyphs (codes 0-7, mirrored at 8-15) shown as '#'
+            fputc(c < 16 ? '#' : (c >= 32 && c < 127 ? (char)c : '?'), out);
+        }
+        fprintf(out, "|\n");
+    }
+    fprintf(out, "+----------------+\n");
+}
+
+// --- LED Matrix Model ---
+
+LedMatrixModel::LedMatrixModel() : pushes(0), begins(0), busNs(0) {
+    words[0] = words[1] = words[2] = 0;
+}
+
+void LedMatrixModel::load(const uint32_t frame[3]) {
+    words[0] = frame[0];
+    words[1] = frame[1];
+    words[2] = frame[2];
+    pushes++;
+}
+
+bool LedMatrixModel::pixel(int x, int y) const {
+    int bit = y * 12 + x;
+    return (words[bit / 32] >> (31 - (bit % 32))) & 1;
+}
+
+void LedMatrixModel::printFrame(FILE* out) const {
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 12; x++) {
+            fputc(pixel(x, y) ? 'O' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
+
+// --- Buzzer Model ---
+
+BuzzerModel::BuzzerModel() : currentFrequency(0), generation(0) {}
+
+void BuzzerModel::start(uint64_t nowNs, uint8_t pin, unsigned int frequency) {
+    generation++;
+    Event e = { nowNs, pin, frequency };
+    events.push_back(e);
+    currentFrequency = frequency;
+}
+
+void BuzzerModel::stop(uint64_t nowNs, uint8_t pin) {
+    generation++;
+    if (currentFrequency == 0) return;
+    Event e = { nowNs, pin, 0 };
+    events.push_back(e);
+    currentFrequency = 0;
+}
+
+// --- Simulator ---
+
+HostSim::HostSim()
+    : timerCalls(0), timerLateNs(0), timerLost(0), pinReads(0), analogReads(0), clockNs(0), ended(false), nextSeq(0),
+      inInterrupt(false), interruptsEnabled(true) {
+    memset(digital, 0, sizeof(digital));
+    memset(analog, 0, sizeof(analog));
+    memset(analogNoise, 0, sizeof(analogNoise));
+    memset(modes, 0, sizeof(modes));
+    memset(pinIsr, 0, sizeof(pinIsr));
+    memset(pinIsrMode, 0, sizeof(pinIsrMode));
+    memset(pinIsrPending, 0, sizeof(pinIsrPending));
+}
+
+bool HostSim::eventAfter(const Event& a, const Event& b) {
+    if (a.timeNs != b.timeNs) return a.timeNs > b.timeNs;
+    return a.seq > b.seq;
+}
+
+void HostSim::addEvent(uint64_t timeNs, EventType type, uint8_t pin, int value) {
+    Event e = { timeNs, nextSeq++, type, pin, value };
+    events.push_back(e);
+    std::push_heap(events.begin(), events.end(), eventAfter);
+}
+
+void HostSim::scheduleToneStop(uint64_t atNs, uint8_t pin) {
+    addEvent(atNs, EV_TONE_STOP, pin, (int)buzzer.generation);
+}
+
+void HostSim::apply(const Event& e) {
+    switch (e.type) {
+        case EV_DIGITAL:
+            if (e.pin < NUM_PINS) {
+                uint8_t level = e.value ? 1 : 0;
+                if (level != digital[e.pin]) {
+                    digital[e.pin] = level;
+                    pinChanged(e.pin, level);
+                }
+            }
+            break;
+        case EV_ANALOG:
+            if (e.pin < NUM_PINS) analog[e.pin] = e.value;
+            break;
+        case EV_NOISE:
+            if (e.pin < NUM_PINS) analogNoise[e.pin] = e.value;
+            break;
+        case EV_DUMP:
+            printf("--- t=%llu ms ---\n", (unsigned long long)(clockNs / 1000000));
+            lcd.printScreen(stdout);
+            matrix.printFrame(stdout);
+            break;
+        case EV_END:
+            ended = true;
+            break;
+        case EV_TONE_STOP:
+            if ((int)buzzer.generation == e.value) buzzer.stop(clockNs, e.pin);
+            break;
+    }
+}
+
+void HostSim::advance(uint64_t ns) {
+    uint64_t target = clockNs + ns;
+
+    // Work done inside a timer callback only moves the clock
+    if (inInterrupt) {
+        clockNs = target;
+        return;
+    }
+
+    for (;;) {
+        int t = interruptsEnabled ? nextTimer(target) : -1;
+        bool haveEvent = !events.empty() && events.front().timeNs <= target;
+
+        if (t >= 0 && (!haveEvent || timers[t].nextNs <= events.front().timeNs)) {
+            fireTimer(timers[t]);
+        } else if (haveEvent) {
+            std::pop_heap(events.begin(), events.end(), eventAfter);
+            Event e = events.back();
+            events.pop_back();
+
+            if (e.timeNs > clockNs) clockNs = e.timeNs;
+            apply(e);
+        } else {
+            break;
+        }
+    }
+    if (clockNs < target) clockNs = target;
+}
+
+// --- Hardware Timers ---
+
+int HostSim::addTimer(uint64_t periodNs, TimerFn fn, void* ctx) {
+    Timer t = { periodNs, 0, fn, ctx, false };
+    timers.push_back(t);
+    return (int)timers.size() - 1;
+}
+
+void HostSim::startTimer(int id) {
+    if (id < 0 || id >= (int)timers.size()) return;
+    timers[id].nextNs = clockNs + timers[id].periodNs;
+    timers[id].running = true;
+}
+
+void HostSim::stopTimer(int id) {
+    if (id >= 0 && id < (int)timers.size()) timers[id].running = false;
+}
+
+void HostSim::setInterrupts(bool enabled) {
+    interruptsEnabled = enabled;
+    if (!enabled || inInterrupt) return;
+
+    // Edges and ticks that came due while masked fire now
+    for (int pin = 0; pin < NUM_PINS; pin++) {
+        if (pinIsrPending[pin]) firePinIsr(pin);
+    }
+    advance(0);
+}
+
+// --- Pin-Change Interrupts ---
+
+void HostSim::attachPinInterrupt(uint8_t pin, PinIsr isr, int mode) {
+    if (pin >= NUM_PINS) return;
+    pinIsr[pin] = isr;
+    pinIsrMode[pin] = mode;
+    pinIsrPending[pin] = false;
+}
+
+void HostSim::pinChanged(uint8_t pin, bool rising) {
+    if (pinIsr[pin] == NULL) return;
+    int mode = pinIsrMode[pin];
+    if (mode == RISING && !rising) return;
+    if (mode == FALLING && rising) return;
+
+    if (interruptsEnabled && !inInterrupt) firePinIsr(pin);
+    else pinIsrPending[pin] = true;
+}
+
+void HostSim::firePinIsr(uint8_t pin) {
+    pinIsrPending[pin] = false;
+    inInterrupt = true;
+    pinIsr[pin]();
+    inInterrupt = false;
+}
+
+// Earliest running timer due at or before 'limitNs', -1 if none
+int HostSim::nextTimer(uint64_t limitNs) const {
+    int best = -1;
+    for (int i = 0; i < (int)timers.size(); i++) {
+        if (!timers[i].running || timers[i].nextNs > limitNs) continue;
+        if (best < 0 || timers[i].nextNs < timers[best].nextNs) best = i;
+    }
+    return best;
+}
+
+void HostSim::fireTimer(Timer& t) {
+    if (t.nextNs > clockNs) clockNs = t.nextNs;
+    else if (clockNs - t.nextNs > timerLateNs) timerLateNs = clockNs - t.nextNs;
+    t.nextNs += t.periodNs;
+
+    // Overflows while this one was pending set the same flag again
+    if (t.nextNs <= clockNs) {
+        uint64_t lost = (clockNs - t.nextNs) / t.periodNs + 1;
+        timerLost += lost;
+        t.nextNs += lost * t.periodNs;
+    }
+
+    timerCalls++;
+    inInterrupt = true;
+    t.fn(t.ctx);
+    inInterrupt = false;
+}
+
+int HostSim::analogSample(uint8_t pin) {
+    int value = analog[pin];
+    if (analogNoise[pin] > 0) {
+        // Own xorshift, so the sketch's random() sequence is unchanged
+        static uint32_t state = 2463534242u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        value += (int)(state % (2 * analogNoise[pin] + 1)) - analogNoise[pin];
+    }
+    if (value < 0) return 0;
+    if (value > 1023) return 1023;
+    return value;
+}
+
+int HostSim::parsePin(const char* token) {
+    if (token[0] == 'A' || token[0] == 'a') return 14 + atoi(token + 1);
+    return atoi(token);
+}
+
+// Script format, one event per line ('#' starts a comment):
+//   <ms> press <pin>            drive pin HIGH
+//   <ms> release <pin>          drive pin LOW
+//   <ms> tap <pin> [hold_ms]    press, release after hold_ms (default 80)
+//   <ms> analog <pin> <value>   set ADC reading (pin may be A0..A5)
+//   <ms> pot <value>            shorthand for "analog A5 <value>"
+//   <ms> noise <pin> <counts>   add +-counts of uniform noise to each ADC reading
+//   <ms> dump                   print LCD and matrix
+//   <ms> end                    stop the simulation
+bool HostSim::loadScript(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[256];
+    int lineNo = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineNo++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char cmd[32], a[32], b[32];
+        unsigned long ms;
+        int n = sscanf(line, "%lu %31s %31s %31s", &ms, cmd, a, b);
+        if (n <= 0) continue;
+        if (n < 2) {
+            fprintf(stderr, "%s:%d: missing command\n", path, lineNo);
+            continue;
+        }
+
+        uint64_t t = (uint64_t)ms * 1000000ULL;
+        if (!strcmp(cmd, "press") && n >= 3) {
+            addEvent(t, EV_DIGITAL, parsePin(a), 1);
+        } else if (!strcmp(cmd, "release") && n >= 3) {
+            addEvent(t, EV_DIGITAL, parsePin(a), 0);
+        } else if (!strcmp(cmd, "tap") && n >= 3) {
+            unsigned long hold = (n >= 4) ? strtoul(b, 0, 10) : 80;
+            addEvent(t, EV_DIGITAL, parsePin(a), 1);
+            addEvent(t + hold * 1000000ULL, EV_DIGITAL, parsePin(a), 0);
+        } else if (!strcmp(cmd, "analog") && n >= 4) {
+            addEvent(t, EV_ANALOG, parsePin(a), atoi(b));
+        } else if (!strcmp(cmd, "pot") && n >= 3) {
+            addEvent(t, EV_ANALOG, 19, atoi(a));
+        } else if (!strcmp(cmd, "noise") && n >= 4) {
+            addEvent(t, EV_NOISE, parsePin(a), atoi(b));
+        } else if (!strcmp(cmd, "dump")) {
+            addEvent(t, EV_DUMP, 0, 0);
+        } else if (!strcmp(cmd, "end")) {
+            addEvent(t, EV_END, 0, 0);
+        } else {
+            fprintf(stderr, "%s:%d: unknown command '%s'\n", path, lineNo, cmd);
+        }
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,212 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+// --- Host Simulator Core ---
+// Virtual clock, pin state, scripted input and in-memory device models
+// behind the host Arduino API (include/). Everything is charged in
+// simulated nanoseconds so frame cost can be measured off the board.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+// --- Bus Cost Model (nanoseconds) ---
+// HD44780 via LiquidCrystal in 4-bit mode: every byte is RS + two nibbles,
+// each nibble is 4 data-pin writes plus an enable pulse (1 us + 1 us) and
+// the library's 100 us settle wait. Clear and home add a 2 ms delay.
+const uint64_t kPinWriteNs       = 1000;
+const uint64_t kEnablePulseNs    = 2000;
+const uint64_t kLcdSettleNs      = 100000;
+const uint64_t kLcdNibbleNs      = 4 * kPinWriteNs + 3 * kPinWriteNs + kEnablePulseNs + kLcdSettleNs;
+const uint64_t kLcdByteNs        = kPinWriteNs + 2 * kLcdNibbleNs;
+const uint64_t kLcdClearHomeNs   = 2000000;
+const uint64_t kLcdInitNs        = 50000000;
+
+// LED matrix: loadPixels() packs 96 bytes into 3 words, loadFrame() copies
+// the words into the buffer the refresh ISR scans.
+const uint64_t kMatrixPixelNs    = 60;
+const uint64_t kMatrixFrameNs    = 2000;
+
+// Core calls
+const uint64_t kDigitalReadNs    = 500;
+const uint64_t kAnalogReadNs     = 20000;
+const uint64_t kToneNs           = 10000;
+
+// --- HD44780 Controller Model ---
+class Hd44780Model {
+public:
+    static const int DDRAM_SIZE = 0x68;
+    static const int ROW_LENGTH = 40;
+
+    Hd44780Model();
+
+    void reset();
+    void send(uint8_t value, bool isData);
+
+    // Visible character code at (col,row), honouring the display shift
+    uint8_t visibleAt(int col, int row) const;
+    void printScreen(FILE* out) const;
+
+    uint8_t ddram[DDRAM_SIZE];
+    uint8_t cgram[64];
+
+    // --- Counters ---
+    uint64_t commands;
+    uint64_t dataBytes;
+    uint64_t clears;
+    uint64_t homes;
+    uint64_t busNs;
+
+private:
+    void command(uint8_t value);
+    void moveAddress(int step);
+
+    uint8_t address;
+    bool cgramMode;
+    bool increment;
+    bool shiftOnWrite;
+    int displayShift;
+};
+
+// --- LED Matrix Model ---
+class LedMatrixModel {
+public:
+    LedMatrixModel();
+
+    void load(const uint32_t frame[3]);
+    bool pixel(int x, int y) const;
+    void printFrame(FILE* out) const;
+
+    uint32_t words[3];
+
+    // --- Counters ---
+    uint64_t pushes;
+    uint64_t begins;  // More than one means competing driver instances
+    uint64_t busNs;
+};
+
+// --- Buzzer Model ---
+class BuzzerModel {
+public:
+    struct Event {
+        uint64_t timeNs;
+        uint8_t pin;
+        unsigned int frequency; // 0 = silence
+    };
+
+    BuzzerModel();
+
+    void start(uint64_t nowNs, uint8_t pin, unsigned int frequency);
+    void stop(uint64_t nowNs, uint8_t pin);
+
+    std::vector<Event> events;
+    unsigned int currentFrequency;
+    uint32_t generation; // Invalidates pending auto-stop events
+};
+
+// --- Simulator ---
+class HostSim {
+public:
+    static const int NUM_PINS = 20;
+
+    HostSim();
+
+    // --- Virtual Clock ---
+    uint64_t nowNs() const { return clockNs; }
+    void advance(uint64_t ns);
+
+    // --- Hardware Timers ---
+    // Periodic callbacks fired from advance() at their exact virtual time,
+    // like a timer ISR preempting whatever the sketch is doing. Costs
+    // charged inside a callback move the clock without nesting. Masked
+    // interrupts hold callbacks back until they are enabled again; as on
+    // the NVIC only one overflow stays pending, so a tick held back for
+    // more than a period loses the ones after it.
+    typedef void (*TimerFn)(void* ctx);
+    int addTimer(uint64_t periodNs, TimerFn fn, void* ctx);
+    void startTimer(int id);
+    void stopTimer(int id);
+    void setInterrupts(bool enabled);
+
+    // Pin-change interrupts: run on a scripted level change that matches
+    // the mode (CHANGE/RISING/FALLING), held back while interrupts are masked
+    typedef void (*PinIsr)();
+    void attachPinInterrupt(uint8_t pin, PinIsr isr, int mode);
+
+    uint64_t timerCalls;
+    uint64_t timerLateNs;     // Worst delay of a callback behind its tick
+    uint64_t timerLost;       // Overflows merged into a pending one
+
+    // --- Pins ---
+    uint8_t digital[NUM_PINS];
+    int analog[NUM_PINS];
+    int analogNoise[NUM_PINS];    // +- counts of uniform noise per conversion
+    uint8_t modes[NUM_PINS];
+
+    // --- Devices ---
+    Hd44780Model lcd;
+    LedMatrixModel matrix;
+    BuzzerModel buzzer;
+
+    // --- Script ---
+    bool loadScript(const char* path);
+    bool finished() const { return ended; }
+
+    // Auto-stop for tone(pin, freq, duration)
+    void scheduleToneStop(uint64_t atNs, uint8_t pin);
+
+    uint64_t pinReads;
+    uint64_t analogReads;
+    int analogSample(uint8_t pin); // analog[pin] plus its noise, clamped to 10 bits
+
+private:
+    enum EventType {
+        EV_DIGITAL,
+        EV_ANALOG,
+        EV_NOISE,
+        EV_DUMP,
+        EV_END,
+        EV_TONE_STOP
+    };
+
+    struct Event {
+        uint64_t timeNs;
+        uint32_t seq;
+        EventType type;
+        uint8_t pin;
+        int value;
+    };
+
+    struct Timer {
+        uint64_t periodNs;
+        uint64_t nextNs;
+        TimerFn fn;
+        void* ctx;
+        bool running;
+    };
+
+    void addEvent(uint64_t timeNs, EventType type, uint8_t pin, int value);
+    int nextTimer(uint64_t limitNs) const;
+    void fireTimer(Timer& t);
+    void pinChanged(uint8_t pin, bool rising);
+    void firePinIsr(uint8_t pin);
+    void apply(const Event& e);
+    static bool eventAfter(const Event& a, const Event& b);
+    static int parsePin(const char* token);
+
+    uint64_t clockNs;
+    bool ended;
+    uint32_t nextSeq;
+    std::vector<Event> events; // Min-heap on (timeNs, seq)
+
+    std::vector<Timer> timers;
+    PinIsr pinIsr[NUM_PINS];
+    int pinIsrMode[NUM_PINS];
+    bool pinIsrPending[NUM_PINS];
+    bool inInterrupt;
+    bool interruptsEnabled;
+};
+
+HostSim& hostSim();
+
+#endif // HOST_SIM_H
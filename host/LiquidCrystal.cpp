@@ -0,0 +1,82 @@
+// --- Host Backend: LiquidCrystal ---
+// Mirrors the byte stream of the Arduino LiquidCrystal library.
+
+#include <LiquidCrystal.h>
+
+#include "HostSim.h"
+
+LiquidCrystal::LiquidCrystal(uint8_t rs, uint8_t enable,
+                             uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3)
+    : displayControl(0), displayMode(0), numLines(1) {
+    (void)rs; (void)enable; (void)d0; (void)d1; (void)d2; (void)d3;
+    setRowOffsets(0x00, 0x40, 0x10, 0x50);
+}
+
+void LiquidCrystal::begin(uint8_t cols, uint8_t rows, uint8_t charsize) {
+    numLines = rows;
+    setRowOffsets(0x00, 0x40, 0x00 + cols, 0x40 + cols);
+
+    // Power-on wait and the 4-bit initialisation dance
+    hostSim().advance(kLcdInitNs);
+    hostSim().lcd.reset();
+
+    command(LCD_FUNCTIONSET | LCD_4BITMODE | (rows > 1 ? LCD_2LINE : LCD_1LINE) | charsize);
+    displayControl = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+    display();
+    clear();
+    displayMode = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+    command(LCD_ENTRYMODESET | displayMode);
+}
+
+void LiquidCrystal::setRowOffsets(int row0, int row1, int row2, int row3) {
+    rowOffsets[0] = row0;
+    rowOffsets[1] = row1;
+    rowOffsets[2] = row2;
+    rowOffsets[3] = row3;
+}
+
+void LiquidCrystal::clear() { command(LCD_CLEARDISPLAY); }
+void LiquidCrystal::home()  { command(LCD_RETURNHOME); }
+
+void LiquidCrystal::setCursor(uint8_t col, uint8_t row) {
+    const uint8_t maxLines = sizeof(rowOffsets) / sizeof(*rowOffsets);
+    if (row >= maxLines) row = maxLines - 1;
+    if (row >= numLines) row = numLines - 1;
+    command(LCD_SETDDRAMADDR | (col + rowOffsets[row]));
+}
+
+void LiquidCrystal::noDisplay() { displayControl &= ~LCD_DISPLAYON; command(LCD_DISPLAYCONTROL | displayControl); }
+void LiquidCrystal::display()   { displayControl |= LCD_DISPLAYON;  command(LCD_DISPLAYCONTROL | displayControl); }
+void LiquidCrystal::noCursor()  { displayControl &= ~LCD_CURSORON;  command(LCD_DISPLAYCONTROL | displayControl); }
+void LiquidCrystal::cursor()    { displayControl |= LCD_CURSORON;   command(LCD_DISPLAYCONTROL | displayControl); }
+void LiquidCrystal::noBlink()   { displayControl &= ~LCD_BLINKON;   command(LCD_DISPLAYCONTROL | displayControl); }
+void LiquidCrystal::blink()     { displayControl |= LCD_BLINKON;    command(LCD_DISPLAYCONTROL | displayControl); }
+
+void LiquidCrystal::scrollDisplayLeft()  { command(LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT); }
+void LiquidCrystal::scrollDisplayRight() { command(LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVERIGHT); }
+
+void LiquidCrystal::leftToRight()  { displayMode |= LCD_ENTRYLEFT;            command(LCD_ENTRYMODESET | displayMode); }
+void LiquidCrystal::rightToLeft()  { displayMode &= ~LCD_ENTRYLEFT;           command(LCD_ENTRYMODESET | displayMode); }
+void LiquidCrystal::autoscroll()   { displayMode |= LCD_ENTRYSHIFTINCREMENT;  command(LCD_ENTRYMODESET | displayMode); }
+void LiquidCrystal::noAutoscroll() { displayMode &= ~LCD_ENTRYSHIFTINCREMENT; command(LCD_ENTRYMODESET | displayMode); }
+
+// Like the board library, this leaves the controller addressing CGRAM:
+// callers must setCursor() before writing characters again.
+void LiquidCrystal::createChar(uint8_t location, uint8_t charmap[]) {
+    location &= 0x7;
+    command(LCD_SETCGRAMADDR | (location << 3));
+    for (int i = 0; i < 8; i++) {
+        write(charmap[i]);
+    }
+}
+
+void LiquidCrystal::command(uint8_t value) { send(value, false); }
+
+size_t LiquidCrystal::write(uint8_t value) {
+    send(value, true);
+    return 1;
+}
+
+void LiquidCrystal::send(uint8_t value, bool isData) {
+    hostSim().lcd.send(value, isData);
+}
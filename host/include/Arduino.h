@@ -0,0 +1,96 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// --- Host Backend: Arduino Core API ---
+// Native Linux implementation of the subset of the Arduino core the sketch
+// uses. Time is virtual (see HostSim.h): it only advances through delay(),
+// modelled bus costs and the simulator's per-loop overhead.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstdlib>
+#include <string.h>
+#include <cmath>
+#include <string>
+
+#include "binary.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// --- Pin Levels & Modes ---
+#define LOW    0
+#define HIGH   1
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+
+#define LED_BUILTIN 13
+
+// UNO R4 analog pins map onto digital numbers 14..19
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+
+#define NUM_DIGITAL_PINS 20
+
+// --- Flash Helpers (flat address space on the host) ---
+#define PROGMEM
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+class __FlashStringHelper;
+#define F(str) (reinterpret_cast<const __FlashStringHelper*>(str))
+
+// --- Digital / Analog I/O ---
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// --- Tone ---
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+// --- Time ---
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// --- Interrupts ---
+void noInterrupts();
+void interrupts();
+
+// External interrupts, as in the Renesas core: digitalPinToInterrupt() is
+// the pin itself, and attachInterrupt() on a pin without an IRQ line
+// (only 2 and 3 on the UNO R4) silently does nothing
+#define CHANGE   2
+#define FALLING  3
+#define RISING   4
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(pin) (pin)
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+// --- Math ---
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+using std::abs;
+
+// --- Sketch Entry Points ---
+void setup();
+void loop();
+
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+
+#endif // HOST_ARDUINO_H
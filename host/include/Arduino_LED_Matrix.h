@@ -0,0 +1,25 @@
+#ifndef HOST_ARDUINO_LED_MATRIX_H
+#define HOST_ARDUINO_LED_MATRIX_H
+
+// --- Host Backend: ArduinoLEDMatrix (UNO R4 WiFi 12x8 matrix) ---
+// Frames are 96 bits packed row-major into three words, MSB first, exactly
+// like the board library. Pushes land in the simulated matrix model.
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Same convenience macro as the board library
+#define renderBitmap(bitmap, rows, columns) loadPixels(&bitmap[0][0], rows * columns)
+
+class ArduinoLEDMatrix {
+public:
+    ArduinoLEDMatrix() {}
+
+    void begin();
+    void end() {}
+    void clear();
+    void loadFrame(const uint32_t buffer[3]);
+    void loadPixels(uint8_t* arr, size_t size);
+};
+
+#endif // HOST_ARDUINO_LED_MATRIX_H
@@ -0,0 +1,55 @@
+#ifndef HOST_FSP_TIMER_H
+#define HOST_FSP_TIMER_H
+
+// --- Host Backend: FspTimer (UNO R4 general purpose timers) ---
+// The subset of the Renesas core's FspTimer the sketch uses. A periodic
+// timer becomes a HostSim timer whose callback fires from the virtual
+// clock, so it keeps running through delay() just like the real ISR.
+
+#include <stdint.h>
+
+#define GPT_TIMER 0
+#define AGT_TIMER 1
+
+typedef enum {
+    TIMER_MODE_PERIODIC,
+    TIMER_MODE_ONE_SHOT,
+    TIMER_MODE_PWM
+} timer_mode_t;
+
+typedef enum {
+    TIMER_EVENT_CYCLE_END
+} timer_event_t;
+
+typedef struct {
+    timer_event_t event;
+    uint32_t capture;
+    void const* p_context;
+} timer_callback_args_t;
+
+typedef void (*GPTimerCbk_f)(timer_callback_args_t*);
+
+class FspTimer {
+public:
+    FspTimer();
+
+    static int8_t get_available_timer(uint8_t& type, bool force = false);
+
+    bool begin(timer_mode_t mode, uint8_t type, uint8_t channel, float freq_hz, float duty_perc,
+               GPTimerCbk_f cbk = nullptr, void* ctx = nullptr);
+    bool setup_overflow_irq(uint8_t priority = 12, void (*isr_fnc)() = nullptr);
+    bool open();
+    bool start();
+    bool stop();
+    void end();
+
+private:
+    static void fire(void* self);
+
+    int id;
+    float frequency;
+    GPTimerCbk_f callback;
+    void* context;
+};
+
+#endif // HOST_FSP_TIMER_H
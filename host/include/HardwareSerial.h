@@ -0,0 +1,25 @@
+#ifndef HOST_HARDWARESERIAL_H
+#define HOST_HARDWARESERIAL_H
+
+// --- Host Backend: Serial (stdout) ---
+
+#include "Print.h"
+
+class HostSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush() override;
+    operator bool() const { return enabled; }
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+
+    bool enabled = true;
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_HARDWARESERIAL_H
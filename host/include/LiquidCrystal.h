@@ -0,0 +1,91 @@
+#ifndef HOST_LIQUIDCRYSTAL_H
+#define HOST_LIQUIDCRYSTAL_H
+
+// --- Host Backend: LiquidCrystal ---
+// Same interface as the Arduino LiquidCrystal library. Every call is turned
+// into the HD44780 byte stream the real library would clock out in 4-bit
+// mode, and fed to the simulated controller (which charges the bus time).
+
+#include <stdint.h>
+#include "Print.h"
+
+// --- HD44780 Commands ---
+#define LCD_CLEARDISPLAY   0x01
+#define LCD_RETURNHOME     0x02
+#define LCD_ENTRYMODESET   0x04
+#define LCD_DISPLAYCONTROL 0x08
+#define LCD_CURSORSHIFT    0x10
+#define LCD_FUNCTIONSET    0x20
+#define LCD_SETCGRAMADDR   0x40
+#define LCD_SETDDRAMADDR   0x80
+
+// Entry mode flags
+#define LCD_ENTRYRIGHT          0x00
+#define LCD_ENTRYLEFT           0x02
+#define LCD_ENTRYSHIFTINCREMENT 0x01
+#define LCD_ENTRYSHIFTDECREMENT 0x00
+
+// Display control flags
+#define LCD_DISPLAYON  0x04
+#define LCD_DISPLAYOFF 0x00
+#define LCD_CURSORON   0x02
+#define LCD_CURSOROFF  0x00
+#define LCD_BLINKON    0x01
+#define LCD_BLINKOFF   0x00
+
+// Display / cursor shift flags
+#define LCD_DISPLAYMOVE 0x08
+#define LCD_CURSORMOVE  0x00
+#define LCD_MOVERIGHT   0x04
+#define LCD_MOVELEFT    0x00
+
+// Function set flags
+#define LCD_8BITMODE 0x10
+#define LCD_4BITMODE 0x00
+#define LCD_2LINE    0x08
+#define LCD_1LINE    0x00
+#define LCD_5x10DOTS 0x04
+#define LCD_5x8DOTS  0x00
+
+class LiquidCrystal : public Print {
+public:
+    LiquidCrystal(uint8_t rs, uint8_t enable,
+                  uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3);
+
+    void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+    void clear();
+    void home();
+
+    void noDisplay();
+    void display();
+    void noBlink();
+    void blink();
+    void noCursor();
+    void cursor();
+    void scrollDisplayLeft();
+    void scrollDisplayRight();
+    void leftToRight();
+    void rightToLeft();
+    void autoscroll();
+    void noAutoscroll();
+
+    void setRowOffsets(int row0, int row1, int row2, int row3);
+    void createChar(uint8_t location, uint8_t charmap[]);
+    void setCursor(uint8_t col, uint8_t row);
+
+    size_t write(uint8_t value) override;
+    void command(uint8_t value);
+
+    using Print::write;
+
+private:
+    void send(uint8_t value, bool isData);
+
+    uint8_t displayControl;
+    uint8_t displayMode;
+    uint8_t numLines;
+    uint8_t rowOffsets[4];
+};
+
+#endif // HOST_LIQUIDCRYSTAL_H
@@ -0,0 +1,46 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// --- Host Backend: Arduino String ---
+// Only the members the sketch uses, backed by std::string. Every
+// construction and concatenation is counted so heap churn shows up in the
+// simulator report just like it would on the board.
+
+#include <string>
+
+class String {
+public:
+    String(const char* s = "");
+    String(const std::string& s);
+    String(char c);
+    String(int value);
+    String(unsigned int value);
+    String(long value);
+    String(unsigned long value);
+    String(const String& other);
+    String& operator=(const String& other);
+
+    unsigned int length() const { return (unsigned int)str.length(); }
+    const char* c_str() const { return str.c_str(); }
+    char charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+
+    String& operator+=(const String& rhs);
+    friend String operator+(const String& lhs, const String& rhs);
+    friend String operator+(const String& lhs, const char* rhs);
+    friend String operator+(const char* lhs, const String& rhs);
+
+    bool operator==(const String& rhs) const { return str == rhs.str; }
+    bool operator!=(const String& rhs) const { return str != rhs.str; }
+
+    // Number of heap allocations made by String objects so far
+    static unsigned long allocations();
+
+private:
+    std::string str;
+};
+
+#endif // HOST_WSTRING_H
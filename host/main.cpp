@@ -0,0 +1,118 @@
+// --- Host Simulator Entry Point ---
+// Runs the unmodified sketch (setup() once, then loop()) against the virtual
+// clock and device models, replays a scripted input file and reports what
+// each device cost in simulated microseconds.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostSim.h"
+#include "BuzzerWav.h"
+
+// CPU time charged for one pass through loop() besides the modelled calls
+static uint64_t loopOverheadNs = 5000;
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [-s script] [-t duration_ms] [-l loop_overhead_us] [-w out.wav] [-q]\n"
+            "  -s  input script (see HostSim.cpp for the format)\n"
+            "  -t  simulated run time in ms (default 10000)\n"
+            "  -l  CPU cost of one loop() pass in us (default 5)\n"
+            "  -w  render the buzzer to a WAV file\n"
+            "  -q  silence the sketch's Serial output\n",
+            argv0);
+}
+
+static double us(uint64_t ns) {
+    return ns / 1000.0;
+}
+
+static void report(uint64_t loops, uint64_t busyLoops, uint64_t maxLoopBusNs, uint64_t maxLoopNs) {
+    HostSim& sim = hostSim();
+    double seconds = sim.nowNs() / 1e9;
+
+    printf("\n=== host simulation: %.3f s simulated ===\n", seconds);
+    sim.lcd.printScreen(stdout);
+    sim.matrix.printFrame(stdout);
+
+    printf("\n--- LCD (HD44780, 4-bit) ---\n");
+    printf("commands        %llu\n", (unsigned long long)sim.lcd.commands);
+    printf("data bytes      %llu\n", (unsigned long long)sim.lcd.dataBytes);
+    printf("clears / homes  %llu / %llu\n", (unsigned long long)sim.lcd.clears, (unsigned long long)sim.lcd.homes);
+    printf("bus time        %.0f us (%.1f%% of run)\n", us(sim.lcd.busNs), seconds > 0 ? 100.0 * sim.lcd.busNs / sim.nowNs() : 0.0);
+
+    printf("\n--- LED matrix ---\n");
+    printf("begin() calls   %llu\n", (unsigned long long)sim.matrix.begins);
+    printf("frame pushes    %llu\n", (unsigned long long)sim.matrix.pushes);
+    printf("push time       %.0f us\n", us(sim.matrix.busNs));
+
+    printf("\n--- Buzzer ---\n");
+    printf("tone events     %llu\n", (unsigned long long)sim.buzzer.events.size());
+
+    printf("\n--- Core ---\n");
+    printf("digitalRead     %llu\n", (unsigned long long)sim.pinReads);
+    printf("analogRead      %llu\n", (unsigned long long)sim.analogReads);
+    printf("String allocs   %lu\n", String::allocations());
+    printf("timer callbacks %llu (worst latency %.0f us, %llu lost)\n", (unsigned long long)sim.timerCalls, us(sim.timerLateNs),
+           (unsigned long long)sim.timerLost);
+
+    printf("\n--- loop() ---\n");
+    printf("passes          %llu (%llu touched a device bus)\n", (unsigned long long)loops, (unsigned long long)busyLoops);
+    printf("max bus / pass  %.0f us\n", us(maxLoopBusNs));
+    printf("max pass time   %.0f us\n", us(maxLoopNs));
+}
+
+int main(int argc, char** argv) {
+    const char* script = 0;
+    const char* wavPath = 0;
+    uint64_t durationMs = 10000;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:t:l:w:qh")) != -1) {
+        switch (opt) {
+            case 's': script = optarg; break;
+            case 't': durationMs = strtoull(optarg, 0, 10); break;
+            case 'l': loopOverheadNs = strtoull(optarg, 0, 10) * 1000ULL; break;
+            case 'w': wavPath = optarg; break;
+            case 'q': Serial.enabled = false; break;
+            default:  usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    HostSim& sim = hostSim();
+    if (script && !sim.loadScript(script)) {
+        fprintf(stderr, "cannot open script '%s'\n", script);
+        return 1;
+    }
+
+    setup();
+
+    uint64_t endNs = durationMs * 1000000ULL;
+    uint64_t loops = 0, busyLoops = 0, maxLoopBusNs = 0, maxLoopNs = 0;
+
+    while (sim.nowNs() < endNs && !sim.finished()) {
+        uint64_t startNs = sim.nowNs();
+        uint64_t startBusNs = sim.lcd.busNs + sim.matrix.busNs;
+
+        loop();
+        sim.advance(loopOverheadNs);
+
+        uint64_t busNs = sim.lcd.busNs + sim.matrix.busNs - startBusNs;
+        uint64_t passNs = sim.nowNs() - startNs;
+        loops++;
+        if (busNs > 0) busyLoops++;
+        if (busNs > maxLoopBusNs) maxLoopBusNs = busNs;
+        if (passNs > maxLoopNs) maxLoopNs = passNs;
+    }
+
+    report(loops, busyLoops, maxLoopBusNs, maxLoopNs);
+
+    if (wavPath && !writeBuzzerWav(wavPath, sim.buzzer, sim.nowNs())) {
+        fprintf(stderr, "cannot write '%s'\n", wavPath);
+        return 1;
+    }
+    return 0;
+}
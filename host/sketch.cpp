@@ -0,0 +1,5 @@
+// --- Host Build of the Sketch ---
+// The Arduino builder prepends Arduino.h to .ino files; do the same here.
+
+#include <Arduino.h>
+#include "../src/src.ino"
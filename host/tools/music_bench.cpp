@@ -0,0 +1,217 @@
+// --- Music Timing Benchmark ---
+// Runs the real GameMusic sequencer on its own against the virtual clock,
+// with a configurable main-loop load, and checks every note the buzzer
+// played against the song's score: onset and sounding length error in
+// microseconds. Optionally renders the buzzer to a WAV file.
+//
+//   music_bench [-s song] [-n passes] [-l load_us] [-m masked_us] [-p] [-w out.wav]
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "HostSim.h"
+#include "BuzzerWav.h"
+#include "GameMusic.h"
+#include "Songs.h"
+
+static const int buzzerPin = 9;
+
+// One note as written in the score, in exact (unquantised) time
+struct ScoreNote {
+    double onsetUs;
+    double lengthUs;
+    int midi;                 // -1 = rest
+};
+
+// One stretch of sound on the buzzer
+struct PlayedNote {
+    double onsetUs;
+    double lengthUs;
+    unsigned int frequency;
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [-s song] [-n passes] [-l load_us] [-m masked_us] [-p] [-w out.wav] [-v]\n"
+            "  -s  song name or library index (default Pacman)\n"
+            "  -n  times through the song (default 1)\n"
+            "  -l  main-loop work per pass in us, >= 1, interrupts on (default 30000)\n"
+            "  -m  of that, us spent with interrupts masked (default 0)\n"
+            "  -p  polled: no timer, GameMusic::update() once per pass\n"
+            "  -w  render the buzzer to a WAV file\n"
+            "  -v  print every note\n",
+            argv0);
+}
+
+static const Song* findSong(const char* key) {
+    char* end;
+    long index = strtol(key, &end, 10);
+    if (*end == '\0') return (index >= 0 && index < songCount) ? songLibrary[index] : NULL;
+    for (int i = 0; i < songCount; i++) {
+        if (!strcasecmp(songLibrary[i]->name, key)) return songLibrary[i];
+    }
+    return NULL;
+}
+
+// Reference decoder: the song as a musician would count it
+static std::vector<ScoreNote> scoreOf(const Song& song, int passes) {
+    std::vector<ScoreNote> notes;
+    double wholeUs = 240e6 / song.tempo;
+    double t = 0;
+    for (int pass = 0; pass < passes; pass++) {
+        uint16_t from = (pass == 0 || song.loopFrom == Song::NO_LOOP) ? 0 : song.loopFrom;
+        bool dotted = false;
+        for (uint16_t i = from; i < song.length; i++) {
+            uint8_t code = song.data[i];
+            uint8_t lengthCode = code >> SongCode::LENGTH_SHIFT;
+            if (lengthCode == SongCode::DOT) {
+                dotted = true;
+                continue;
+            }
+            uint8_t pitch = code & SongCode::PITCH_MASK;
+            double length = wholeUs / (1 << (5 - lengthCode)) * (dotted ? 1.5 : 1.0);
+            ScoreNote n = { t, length, pitch ? song.base + pitch - 1 : -1 };
+            notes.push_back(n);
+            t += length;
+            dotted = false;
+        }
+        if (song.loopFrom == Song::NO_LOOP) break;
+    }
+    return notes;
+}
+
+static std::vector<PlayedNote> playedOf(const BuzzerModel& buzzer, uint64_t startNs) {
+    std::vector<PlayedNote> notes;
+    for (size_t i = 0; i < buzzer.events.size(); i++) {
+        const BuzzerModel::Event& e = buzzer.events[i];
+        if (e.frequency == 0) continue;
+        uint64_t endNs = (i + 1 < buzzer.events.size()) ? buzzer.events[i + 1].timeNs : e.timeNs;
+        PlayedNote n = { (e.timeNs - startNs) / 1e3, (endNs - e.timeNs) / 1e3, e.frequency };
+        notes.push_back(n);
+    }
+    return notes;
+}
+
+static const char* noteName(int midi, char* buf) {
+    static const char* names[12] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+    if (midi < 0) return "rest";
+    snprintf(buf, 12, "%s%d", names[midi % 12], midi / 12 - 1);
+    return buf;
+}
+
+int main(int argc, char** argv) {
+    const Song* song = &songPacman;
+    int passes = 1;
+    uint64_t loadNs = 30000000ULL;
+    uint64_t maskedNs = 0;
+    bool polled = false;
+    bool verbose = false;
+    const char* wavPath = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:n:l:m:pw:vh")) != -1) {
+        switch (opt) {
+            case 's':
+                song = findSong(optarg);
+                if (!song) {
+                    fprintf(stderr, "unknown song '%s'\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'n': passes = atoi(optarg); break;
+            case 'l': loadNs = strtoull(optarg, 0, 10) * 1000ULL; break;
+            case 'm': maskedNs = strtoull(optarg, 0, 10) * 1000ULL; break;
+            case 'p': polled = true; break;
+            case 'w': wavPath = optarg; break;
+            case 'v': verbose = true; break;
+            default:  usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (maskedNs > loadNs) loadNs = maskedNs;
+    if (loadNs == 0) {
+        fprintf(stderr, "load must be at least 1 us: a pass has to advance the clock\n");
+        return 2;
+    }
+    Serial.enabled = false;
+
+    std::vector<ScoreNote> score = scoreOf(*song, passes);
+    double scoreEndUs = score.empty() ? 0 : score.back().onsetUs + score.back().lengthUs;
+
+    // --- Run ---
+    HostSim& sim = hostSim();
+    GameMusic music(buzzerPin);
+    if (!polled && !music.begin()) {
+        fprintf(stderr, "no timer available\n");
+        return 1;
+    }
+
+    delay(1); // Start off a tick boundary
+    uint64_t startNs = sim.nowNs();
+    music.play(*song);
+    uint64_t endNs = startNs + (uint64_t)(scoreEndUs * 1000.0);
+
+    while (sim.nowNs() < endNs) {
+        music.update();
+        noInterrupts();
+        sim.advance(maskedNs);
+        interrupts();
+        sim.advance(loadNs - maskedNs);
+    }
+    music.stopMusic();
+
+    // --- Compare ---
+    std::vector<PlayedNote> played = playedOf(sim.buzzer, startNs);
+
+    printf("=== music bench: %s, %d bpm, %d pass%s, %s, load %.0f us/pass (%.0f us masked) ===\n",
+           song->name, song->tempo, passes, passes == 1 ? "" : "es", polled ? "polled" : "timer",
+           loadNs / 1e3, maskedNs / 1e3);
+    if (verbose) printf("   #  note   score_on  actual_on   err_us  score_len actual_len   err_us\n");
+
+    size_t p = 0;
+    int compared = 0, missing = 0;
+    double sumOnset = 0, maxOnset = 0, sumLength = 0, maxLength = 0;
+    for (size_t i = 0; i < score.size(); i++) {
+        const ScoreNote& s = score[i];
+        if (s.midi < 0) continue;
+
+        // Sounding part of the note: 9/10 of its length
+        double scoreLength = s.lengthUs * 0.9;
+        char name[12];
+        if (p >= played.size()) {
+            missing++;
+            if (verbose) printf("%4zu  %-5s %10.0f  (not played)\n", i, noteName(s.midi, name), s.onsetUs);
+            continue;
+        }
+        const PlayedNote& a = played[p++];
+        double onsetErr = a.onsetUs - s.onsetUs;
+        double lengthErr = a.lengthUs - scoreLength;
+        compared++;
+        sumOnset += fabs(onsetErr);
+        sumLength += fabs(lengthErr);
+        if (fabs(onsetErr) > maxOnset) maxOnset = fabs(onsetErr);
+        if (fabs(lengthErr) > maxLength) maxLength = fabs(lengthErr);
+
+        if (verbose) {
+            printf("%4zu  %-5s %10.0f %10.0f %8.0f %10.0f %10.0f %8.0f\n", i, noteName(s.midi, name),
+                   s.onsetUs, a.onsetUs, onsetErr, scoreLength, a.lengthUs, lengthErr);
+        }
+    }
+
+    printf("notes           %d compared, %d missing, %zu extra\n", compared, missing, played.size() - p);
+    printf("onset error     mean %.0f us, max %.0f us\n", compared ? sumOnset / compared : 0.0, maxOnset);
+    printf("length error    mean %.0f us, max %.0f us\n", compared ? sumLength / compared : 0.0, maxLength);
+    printf("sequencer       drift max %lu us, tick jitter max %lu us\n", music.maxDriftUs, music.maxJitterUs);
+    printf("timer           %llu callbacks, worst latency %.0f us, %llu lost\n",
+           (unsigned long long)sim.timerCalls, sim.timerLateNs / 1e3, (unsigned long long)sim.timerLost);
+
+    if (wavPath && !writeBuzzerWav(wavPath, sim.buzzer, sim.nowNs())) {
+        fprintf(stderr, "cannot write '%s'\n", wavPath);
+        return 1;
+    }
+    return 0;
+}
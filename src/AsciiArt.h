@@ -0,0 +1,52 @@
+#ifndef ASCII_ART_H
+#define ASCII_ART_H
+
+#include <Arduino.h>
+#include "MatrixFrame.h"
+#include "GlyphCache.h"
+
+// --- Compile-Time Bitmap Assets ---
+// Draw matrix frames and LCD glyphs as one string per row, '.' for off and
+// anything else (we use '#') for on. Assign the result to a constexpr
+// variable and the compiler packs it into flash: no RAM tables, no pixel
+// loops at run time. Rows of the wrong size fail with a static_assert.
+//
+//   static constexpr MatrixFrame heart = matrixArt(
+//       "............",
+//       "..##...##...",
+//       ...);
+
+template <size_t... N>
+constexpr MatrixFrame matrixArt(const char (&... rows)[N]) {
+    static_assert(sizeof...(N) == MatrixFrame::HEIGHT, "matrix art needs 8 rows");
+    static_assert(((N == MatrixFrame::WIDTH + 1) && ...), "matrix art rows must be 12 columns");
+
+    const char* lines[] = { rows... };
+    uint32_t words[3] = { 0, 0, 0 };
+    for (int y = 0; y < MatrixFrame::HEIGHT; y++) {
+        for (int x = 0; x < MatrixFrame::WIDTH; x++) {
+            if (lines[y][x] == '.') continue;
+            int i = y * MatrixFrame::WIDTH + x;
+            words[i >> 5] |= 0x80000000UL >> (i & 31);
+        }
+    }
+    return MatrixFrame(words[0], words[1], words[2]);
+}
+
+// 5x8 HD44780 custom character, leftmost column in bit 4
+template <size_t... N>
+constexpr Glyph glyphArt(const char (&... rows)[N]) {
+    static_assert(sizeof...(N) == 8, "glyph art needs 8 rows");
+    static_assert(((N == 5 + 1) && ...), "glyph art rows must be 5 columns");
+
+    const char* lines[] = { rows... };
+    Glyph glyph = {};
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 5; x++) {
+            if (lines[y][x] != '.') glyph.rows[y] |= 0x10 >> x;
+        }
+    }
+    return glyph;
+}
+
+#endif // ASCII_ART_H
@@ -1,77 +1,122 @@
 #include "BlockBreaker.h"
+#include "TextLayout.h"
+#include "AsciiArt.h"
+#include "Songs.h"
+#include "BrickLevels.h"
+
+// --- Matrix Frames (flash) ---
+
+// Frame: Smiley (Victory)
+static constexpr MatrixFrame victoryFrame = matrixArt(
+    "............",
+    "............",
+    "...#....#...",
+    "............",
+    "............",
+    "...#....#...",
+    "....####....",
+    "............");
+
+// Frame: Big X (Game Over)
+static constexpr MatrixFrame gameOverFrame = matrixArt(
+    "............",
+    "..#...#.....",
+    "...#.#......",
+    "....#.......",
+    "...#.#......",
+    "..#...#.....",
+    "............",
+    "............");
 
 // --- Constructor ---
-BlockBreaker::BlockBreaker(LiquidCrystal& lcdRef, int pPin, int bPin) 
-    : lcd(lcdRef), potPin(pPin), buttonPin(bPin) {
+BlockBreaker::BlockBreaker(const Console& console) 
+    : lcd(console.screen), display(console.display), music(console.music), pot(console.pot), buttons(console.buttons), buttonPin(console.selectPin) {
 }
 
 // --- Initialization & Control ---
 
-void BlockBreaker::begin() {
-    matrix.begin(); // Hardware init
-    pinMode(buttonPin, INPUT);
-}
+void BlockBreaker::enter() {
+    buttons.add(buttonPin);
 
-void BlockBreaker::start() {
     // Intro UI
     lcd.clear();
     lcd.setCursor(0, 0);
     lcd.print("BRICK");
     lcd.setCursor(0, 1);
     lcd.print("BREAKER");
-    delay(3000);
-    
-    resetGame();
-}
 
-void BlockBreaker::stop() {
-    // Clear Buffer
-    for(int y=0; y<8; y++) {
-        for(int x=0; x<12; x++) {
-            frame[y][x] = 0;
-        }
-    }
-    // Update Matrix
-    matrix.renderBitmap(frame, 8, 12);
+    music.play(songKorobeiniki);
+    state = BB_INTRO;
+    introEnd.start(INTRO_MS);
 }
 
+// Nothing held: the console takes the matrix back itself
+void BlockBreaker::exit() {}
+
 // --- Game Setup Helpers ---
 
-void BlockBreaker::initBricks() {
-    totalBricks = 0;
-    // Create 3 rows of bricks
-    for (int y = 0; y < 3; y++) {
+// Unpacks the current level from flash into the bitboards
+void BlockBreaker::loadLevel() {
+    const BrickLevel& layout = brickLevels[level];
+    bricks.clear();
+    armor.clear();
+    fixed.clear();
+    for (int y = 0; y < BRICK_ROWS; y++) {
         for (int x = 0; x < 12; x++) {
-            bricks[y][x] = true;
-            totalBricks++;
+            BrickCell cell = layout.cell(x, y);
+            if (cell == BRICK_EMPTY) continue;
+            bricks.set(x, y);
+            if (cell == BRICK_TOUGH) armor.set(x, y);
+            else if (cell == BRICK_FIXED) fixed.set(x, y);
         }
     }
+    bricksAtStart = bricksLeft();
+}
+
+// Breakable bricks still standing: two popcounts
+int BlockBreaker::bricksLeft() const {
+    return bricks.count() - fixed.count();
 }
 
 void BlockBreaker::resetGame() {
+    level = 0;
+    score = 0;
+    startLevel();
+}
+
+void BlockBreaker::startLevel() {
     state = BB_WAITING;
-    initBricks();
+    loadLevel();
     
-    // Initial Ball Position
-    ballX = 6;
-    ballY = 6; 
-    ballDirX = 0.5; 
-    ballDirY = -1;  
+    // One ball, centred in cell (6, 6), heading up
+    balls.clear();
+    particles.clear();
+    spawnBall((6 << FIX_SHIFT) + FIX_HALF, (6 << FIX_SHIFT) + FIX_HALF, SLOPE_SHALLOW, -1);
+    speed = SPEED_START;
     
     lastBallUpdate = millis();
+    stepBacklogMs = 0;
     
     // Reset UI
     lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print("Score: 0");
+    drawScore();
+    lcd.setCursor(13, 0);
+    lcd.print("L");
+    lcd.print(level + 1);
     lcd.setCursor(0, 1);
     lcd.print("Press Jump/Start");
 }
 
+void BlockBreaker::drawScore() {
+    lcd.setCursor(0, 0);
+    lcd.print("Score:");
+    printNumberRight(lcd, score, 6); // Fixed field: ends before the level tag
+}
+
 // --- Physics Logic ---
 
 void BlockBreaker::updatePaddle() {
-    int potValue = analogRead(potPin);
+    int potValue = pot.value();
     // Map Pot to Matrix Width
     paddleX = map(potValue, 0, 1023, 12 - paddleWidth, 0);
     
@@ -81,137 +126,288 @@ void BlockBreaker::updatePaddle() {
 }
 
 void BlockBreaker::updateBall() {
-    if (millis() - lastBallUpdate > ballSpeedDelay) {
-        lastBallUpdate = millis();
-        
-        // Calculate Next Pos
-        float nextX = ballX + ballDirX;
-        float nextY = ballY + ballDirY;
-        
-        // 1. Wall Collision (Left/Right)
-        if (nextX < 0 || nextX >= 12) {
-            ballDirX *= -1; 
-            nextX = ballX + ballDirX; 
+    // Elapsed time is banked and spent in fixed steps, so the ball moves
+    // the same whatever the loop rate
+    unsigned long now = millis();
+    stepBacklogMs += now - lastBallUpdate;
+    lastBallUpdate = now;
+    if (stepBacklogMs > MAX_CATCH_UP_MS) stepBacklogMs = MAX_CATCH_UP_MS; // No leap after a stall
+
+    while (stepBacklogMs >= STEP_MS && state == BB_PLAYING) {
+        stepBacklogMs -= STEP_MS;
+        for (uint32_t m = balls.live(); m != 0 && state == BB_PLAYING; m &= m - 1) {
+            stepBall(EntityPool<MAX_BALLS>::slot(m));
         }
-        
-        // 2. Ceiling Collision
-        if (nextY < 0) {
-            ballDirY *= -1; 
-            nextY = ballY + ballDirY;
+        stepParticles();
+    }
+}
+
+void BlockBreaker::spawnBall(int16_t x, int16_t y, int16_t slope, int8_t dy) {
+    int8_t i = balls.spawn();
+    if (i == EntityPool<MAX_BALLS>::NONE) return; // Pool full: no extra ball
+    ballX[i] = x;
+    ballY[i] = y;
+    slopeX[i] = slope;
+    dirY[i] = dy;
+}
+
+// Two specks of debris flying apart and falling from brick (x, y)
+void BlockBreaker::spawnDebris(int x, int y) {
+    for (int side = -1; side <= 1; side += 2) {
+        int8_t i = particles.spawn();
+        if (i == EntityPool<MAX_PARTICLES>::NONE) return;
+        particleX[i] = (x << FIX_SHIFT) + FIX_HALF;
+        particleY[i] = (y << FIX_SHIFT) + FIX_HALF;
+        particleVX[i] = side * PARTICLE_SPEED;
+        particleVY[i] = 0;
+        particleLife[i] = PARTICLE_LIFE;
+    }
+}
+
+// One pass over the live particles, field by field
+void BlockBreaker::stepParticles() {
+    for (uint32_t m = particles.live(); m != 0; m &= m - 1) {
+        int i = EntityPool<MAX_PARTICLES>::slot(m);
+        particleX[i] += particleVX[i];
+        particleVY[i] += GRAVITY;
+        particleY[i] += particleVY[i];
+        if (--particleLife[i] == 0 || particleX[i] < 0 || particleX[i] >= (12 << FIX_SHIFT) ||
+            particleY[i] >= (8 << FIX_SHIFT)) {
+            particles.despawn(i);
         }
-        
-        // 3. Floor Collision (Game Over)
-        if (nextY >= 8) {
-            state = BB_GAME_OVER;
-            lcd.clear();
-            lcd.setCursor(0, 0);
-            lcd.print("GAME OVER!");
-            lcd.setCursor(0, 1);
-            lcd.print("Btn to Restart");
+    }
+}
+
+// Moves ball i one step, visiting every LED cell its path crosses in
+// order (DDA), so it cannot slip diagonally between two bricks. The first
+// solid cell reflects it and ends the step.
+void BlockBreaker::stepBall(int i) {
+    int16_t& ballX = this->ballX[i];
+    int16_t& ballY = this->ballY[i];
+    int16_t& slopeX = this->slopeX[i];
+    int8_t& dirY = this->dirY[i];
+
+    int sx = (slopeX < 0) ? -1 : 1;
+    int sy = dirY;
+    int32_t adx = (int32_t)speed * (slopeX < 0 ? -slopeX : slopeX) / 256;
+    int32_t ady = speed;
+
+    for (;;) {
+        int cx = ballX >> FIX_SHIFT;
+        int cy = ballY >> FIX_SHIFT;
+
+        // Distance to the next cell on each axis, in 1/256 LED
+        int32_t ex = (sx > 0) ? ((cx + 1) << FIX_SHIFT) - ballX : ballX - (cx << FIX_SHIFT) + 1;
+        int32_t ey = (sy > 0) ? ((cy + 1) << FIX_SHIFT) - ballY : ballY - (cy << FIX_SHIFT) + 1;
+        bool crossX = adx > 0 && ex <= adx;
+        bool crossY = ady > 0 && ey <= ady;
+
+        // Both reachable: the nearer boundary (ex/adx vs ey/ady) goes first
+        if (crossX && crossY) {
+            int32_t tx = ex * ady;
+            int32_t ty = ey * adx;
+            if (tx < ty) crossY = false;
+            else if (ty < tx) crossX = false;
+        }
+
+        if (!crossX && !crossY) {
+            ballX += sx * adx;
+            ballY += sy * ady;
             return;
         }
-        
-        // 4. Paddle Collision
-        if (ballDirY > 0 && nextY >= 7 && ballY < 8) {
-            int ballIntX = (int)nextX;
-            if (ballIntX >= paddleX && ballIntX < paddleX + paddleWidth) {
-                ballDirY *= -1; // Bounce Up
-                
-                // Paddle Angle Physics
-                if (ballIntX == paddleX) ballDirX = -0.7; 
-                else if (ballIntX == paddleX + paddleWidth - 1) ballDirX = 0.7; 
-                
-                nextY = ballY + ballDirY; 
-            }
+
+        // Advance to the boundary
+        int32_t mx, my;
+        if (crossX && crossY) {
+            mx = ex;
+            my = ey;
+        } else if (crossX) {
+            mx = ex;
+            my = ady * ex / adx;
+        } else {
+            my = ey;
+            mx = adx * ey / ady;
         }
-        
-        // 5. Brick Collision
-        int brickX = (int)nextX;
-        int brickY = (int)nextY;
-        
-        if (brickY >= 0 && brickY < 3 && brickX >= 0 && brickX < 12) {
-            if (bricks[brickY][brickX]) {
-                bricks[brickY][brickX] = false; // Destroy
-                totalBricks--;
-                ballDirY *= -1; // Bounce
-                
-                // Update Score
-                lcd.setCursor(7, 0);
-                lcd.print(36 - totalBricks);
-                
-                if (totalBricks <= 0) {
-                    state = BB_VICTORY;
-                    lcd.clear();
-                    lcd.setCursor(0,0);
-                    lcd.print("YOU WIN!");
-                }
-            }
+        ballX += sx * mx;
+        ballY += sy * my;
+        adx -= mx;
+        ady -= my;
+
+        int nx = cx + sx;
+        int ny = cy + sy;
+        bool hitX = crossX && isSolid(nx, cy);
+        bool hitY = crossY && isSolid(cx, ny);
+        bool hitCorner = crossX && crossY && !hitX && !hitY && isSolid(nx, ny);
+        if (!hitX && !hitY && !hitCorner) continue;
+
+        // Bounce: step back into the cell we came from
+        if (hitX || hitCorner) {
+            ballX -= sx;
+            slopeX = -slopeX;
         }
-        
-        // Apply Physics
-        ballX += ballDirX;
-        ballY += ballDirY;
+        if (hitY || hitCorner) {
+            ballY -= sy;
+            dirY = -dirY;
+        }
+        if (hitX) onHit(i, nx, cy);
+        if (hitY && balls.isLive(i)) onHit(i, cx, ny);
+        if (hitCorner) onHit(i, nx, ny);
+        return;
     }
 }
 
-// --- Rendering ---
+// Walls, ceiling, floor, paddle and bricks
+bool BlockBreaker::isSolid(int x, int y) {
+    if (x < 0 || x >= 12 || y < 0 || y >= 8) return true;
+    if (y == 7) return x >= paddleX && x < paddleX + paddleWidth;
+    return bricks.get(x, y);
+}
 
-void BlockBreaker::draw() {
-    // Clear Buffer
-    for(int y=0; y<8; y++) {
-        for(int x=0; x<12; x++) {
-            frame[y][x] = 0;
+// Effects of ball i bouncing off cell (x, y); the ball is already reflected
+void BlockBreaker::onHit(int i, int x, int y) {
+    // 1. Floor: the ball is lost, the game with the last one
+    if (y >= 8) {
+        balls.despawn(i);
+        if (balls.count() > 0) return;
+
+        state = BB_GAME_OVER;
+        music.playEffect(sfxLose);
+        lcd.clear();
+        lcd.setCursor(0, 0);
+        lcd.print("GAME OVER!");
+        lcd.setCursor(0, 1);
+        lcd.print("Btn to Restart");
+        return;
+    }
+
+    // 2. Walls and Ceiling
+    if (x < 0 || x >= 12 || y < 0) {
+        music.playEffect(sfxWall);
+        return;
+    }
+
+    // 3. Paddle: always leaves upwards, edges steer
+    if (y == 7) {
+        dirY[i] = -1;
+        if (x == paddleX) slopeX[i] = -SLOPE_STEEP;
+        else if (x == paddleX + paddleWidth - 1) slopeX[i] = SLOPE_STEEP;
+        music.playEffect(sfxPaddle);
+        return;
+    }
+
+    // 4. Bricks: unbreakable, cracked, or gone
+    if (fixed.get(x, y)) {
+        music.playEffect(sfxWall);
+        return;
+    }
+    if (armor.get(x, y)) {
+        armor.reset(x, y);
+        music.playEffect(sfxPaddle);
+        return;
+    }
+    bricks.reset(x, y); // Destroy
+    score++;
+    music.playEffect(sfxBrick);
+    spawnDebris(x, y);
+
+    // Multi-ball: every few bricks one more ball drops out of the wall
+    if (score % MULTIBALL_EVERY == 0) {
+        spawnBall((x << FIX_SHIFT) + FIX_HALF, (y << FIX_SHIFT) + FIX_HALF, -slopeX[i], 1);
+        music.playEffect(sfxBonus);
+    }
+
+    // Speed ramp: from SPEED_START to SPEED_MAX as the wall comes down
+    int left = bricksLeft();
+    speed = SPEED_START + (int32_t)(SPEED_MAX - SPEED_START) * (bricksAtStart - left) / bricksAtStart;
+
+    drawScore();
+
+    if (left == 0) {
+        state = BB_VICTORY;
+        music.playEffect(sfxWin);
+        lcd.clear();
+        lcd.setCursor(0,0);
+        if (level + 1 < brickLevelCount) {
+            lcd.print("LEVEL CLEAR!");
+            lcd.setCursor(0, 1);
+            lcd.print("Btn: Next Level");
+        } else {
+            lcd.print("YOU WIN!");
+            lcd.setCursor(0, 1);
+            lcd.print("Btn to Restart");
         }
     }
+}
+
+// --- Rendering ---
+
+void BlockBreaker::draw() {
+    MatrixFrame& frame = display.back();
     
     if (state == BB_VICTORY) {
-        // Smiley Face
-        frame[2][3]=1; frame[2][8]=1; 
-        frame[5][3]=1; frame[6][4]=1; frame[6][5]=1; frame[6][6]=1; frame[6][7]=1; frame[5][8]=1; 
+        frame = victoryFrame;   // Three word copies
     } 
     else if (state == BB_GAME_OVER) {
-        // Big X
-        frame[1][2]=1; frame[2][3]=1; frame[3][4]=1; frame[4][5]=1; frame[5][6]=1;
-        frame[5][2]=1; frame[4][3]=1; frame[3][4]=1; frame[2][5]=1; frame[1][6]=1;
+        frame = gameOverFrame;
     }
     else {
-        // 1. Bricks
-        for(int y=0; y<3; y++) {
-            for(int x=0; x<12; x++) {
-                if (bricks[y][x]) frame[y][x] = 1;
-            }
-        }
+        frame.clear();
+        
+        // 1. Bricks: one OR per word; armoured bricks blink
+        frame.blit(bricks);
+        if (millis() & 256) frame.erase(armor);
         
         // 2. Paddle
         for(int i=0; i<paddleWidth; i++) {
              int px = paddleX + i;
-             if(px < 12) frame[7][px] = 1;
+             if(px < 12) frame.set(px, 7);
         }
         
-        // 3. Ball
-        int bx = (int)ballX;
-        int by = (int)ballY;
-        if(bx >= 0 && bx < 12 && by >= 0 && by < 8) {
-            frame[by][bx] = 1;
+        // 3. Balls and debris
+        for (uint32_t m = balls.live(); m != 0; m &= m - 1) {
+            int i = EntityPool<MAX_BALLS>::slot(m);
+            frame.set(ballX[i] >> FIX_SHIFT, ballY[i] >> FIX_SHIFT);
+        }
+        for (uint32_t m = particles.live(); m != 0; m &= m - 1) {
+            int i = EntityPool<MAX_PARTICLES>::slot(m);
+            frame.set(particleX[i] >> FIX_SHIFT, particleY[i] >> FIX_SHIFT);
         }
     }
     
-    // Push to Hardware
-    matrix.renderBitmap(frame, 8, 12);
+    // Swap to Front (pushed by the render task)
+    display.present(this);
 }
 
 // --- Main Loop ---
-void BlockBreaker::run() {
+void BlockBreaker::tick() {
+    if (state == BB_INTRO) {
+        if (!introEnd.passed()) return;
+        display.lease(this);
+        events = buttons.reader(); // Only presses from here on
+        resetGame();
+        return;
+    }
+
     updatePaddle(); 
+
+    // A press is one event however long the button is held
+    bool pressed = false;
+    ButtonInput::Event event;
+    while (events.pop(event)) {
+        if (event.pressed(buttonPin)) pressed = true;
+    }
     
     if (state == BB_WAITING) {
         draw();
         // Start Trigger
-        if (digitalRead(buttonPin) == HIGH) {
+        if (pressed) {
             state = BB_PLAYING;
             lcd.setCursor(0, 1);
-            lcd.print("Running...      ");
-            delay(200); 
+            printPadded(lcd, "Running...", 16);
+
+            // Serve: physics time starts now
+            lastBallUpdate = millis();
+            stepBacklogMs = 0;
         }
     }
     else if (state == BB_PLAYING) {
@@ -221,10 +417,14 @@ void BlockBreaker::run() {
     else {
         // End State (Win/Loss)
         draw();
-        // Restart Trigger
-        if (digitalRead(buttonPin) == HIGH) {
-            resetGame();
-            delay(500); 
+        // Next level after a win, else start over
+        if (pressed) {
+            if (state == BB_VICTORY && level + 1 < brickLevelCount) {
+                level++;
+                startLevel();
+            } else {
+                resetGame();
+            }
         }
     }
 }
\ No newline at end of file
@@ -2,11 +2,18 @@
 #define BLOCK_BREAKER_H
 
 #include <Arduino.h>
-#include <LiquidCrystal.h>
-#include "Arduino_LED_Matrix.h" 
+#include "LcdBuffer.h"
+#include "MatrixDisplay.h"
+#include "GameMusic.h"
+#include "PotInput.h"
+#include "ButtonInput.h"
+#include "Game.h"
+#include "Console.h"
+#include "EntityPool.h"
 
 // --- Game States ---
 enum BBState {
+    BB_INTRO,
     BB_WAITING,
     BB_PLAYING,
     BB_GAME_OVER,
@@ -14,51 +21,96 @@ enum BBState {
 };
 
 // --- Class Definition ---
-class BlockBreaker {
+class BlockBreaker : public Game {
 public:
+    static constexpr const char* MENU_NAME = "Brick Breaker";
+
     // --- Constructor ---
-    BlockBreaker(LiquidCrystal& lcdRef, int pPin, int bPin);
-    
-    // --- Main Methods ---
-    void begin(); // Hardware init (run once)
-    void start(); // Game session start
-    void run();   // Main loop
-    void stop();  // Cleanup
+    BlockBreaker(const Console& console);
+
+    // --- Game ---
+    void enter() override; // Game session start (matrix lease after the intro)
+    void tick() override;  // Main loop
+    void exit() override;
 
 private:
     // --- Hardware References ---
-    LiquidCrystal& lcd;
-    ArduinoLEDMatrix matrix; 
+    LcdBuffer& lcd;
+    MatrixDisplay& display;
+    GameMusic& music;
     
     // --- Controls ---
-    int potPin;
+    PotInput& pot;             // Filtered in the background
+    ButtonInput& buttons;
+    ButtonInput::Reader events; // Presses since the last tick
     int buttonPin;
     
     // --- State Variables ---
     BBState state;
-    
-    // --- Graphics Buffer ---
-    uint8_t frame[8][12]; 
+    Deadline introEnd;
+    static const unsigned long INTRO_MS = 3000;
     
     // --- Paddle Physics ---
     int paddleX;
     const int paddleWidth = 3; 
     
-    // --- Ball Physics ---
-    float ballX, ballY;
-    float ballDirX, ballDirY;
+    // --- Ball Physics (Q8.8 fixed point: 256 = one LED) ---
+    static const int FIX_SHIFT = 8;
+    static const int16_t FIX_HALF = 1 << (FIX_SHIFT - 1);
+    static const unsigned int STEP_MS = 16;         // Fixed physics step
+    static const unsigned int MAX_CATCH_UP_MS = 100; // Backlog kept after a stall
+    static const int16_t SPEED_START = 16;          // LED/256 per step (~3.9 LED/s)
+    static const int16_t SPEED_MAX = 40;            // Reached with the last brick (~9.8 LED/s)
+    static const int16_t SLOPE_SHALLOW = 128;       // Horizontal share of speed /256
+    static const int16_t SLOPE_STEEP = 179;         // After a paddle edge hit
+
+    int16_t speed;            // Q8.8 LEDs per step, shared by all balls
     unsigned long lastBallUpdate;
-    const int ballSpeedDelay = 250; 
+    unsigned int stepBacklogMs;
+
+    // --- Entities (fixed pools, structure of arrays) ---
+    // Worst case per step: MAX_BALLS swept moves (at most 3 cell
+    // crossings each, as speed < 1 LED per step) plus MAX_PARTICLES
+    // integrations; at most MAX_CATCH_UP_MS / STEP_MS steps per pass.
+    static const uint8_t MAX_BALLS = 3;
+    static const uint8_t MAX_PARTICLES = 8;
+    static const int MULTIBALL_EVERY = 12;          // Bricks broken per extra ball
+    static const uint8_t PARTICLE_LIFE = 20;        // Steps (~320 ms)
+    static const int16_t PARTICLE_SPEED = 20;       // Q8.8 per step, sideways
+    static const int16_t GRAVITY = 3;               // Q8.8 per step, per step
+
+    EntityPool<MAX_BALLS> balls;
+    int16_t ballX[MAX_BALLS], ballY[MAX_BALLS];     // Q8.8, LED coordinates
+    int16_t slopeX[MAX_BALLS];                      // Signed, /256 of speed
+    int8_t dirY[MAX_BALLS];                         // +1 = down
+
+    EntityPool<MAX_PARTICLES> particles;            // Brick debris
+    int16_t particleX[MAX_PARTICLES], particleY[MAX_PARTICLES];
+    int16_t particleVX[MAX_PARTICLES], particleVY[MAX_PARTICLES];
+    uint8_t particleLife[MAX_PARTICLES];
     
-    // --- Level Data ---
-    bool bricks[3][12]; 
-    int totalBricks;
+    // --- Level Data (bitboards in matrix frame layout) ---
+    MatrixFrame bricks;       // Every brick still standing
+    MatrixFrame armor;        // Bricks that take one more hit
+    MatrixFrame fixed;        // Unbreakable bricks
+    uint8_t level;            // Index into brickLevels
+    int bricksAtStart;        // Breakable bricks in the level
+    int score;                // Bricks broken, across levels
     
     // --- Internal Helpers ---
     void resetGame();
-    void initBricks();
+    void startLevel();
+    void loadLevel();
+    int bricksLeft() const;
+    void drawScore();
     void updatePaddle();
     void updateBall();
+    void stepBall(int i);
+    void stepParticles();
+    void spawnBall(int16_t x, int16_t y, int16_t slope, int8_t dy);
+    void spawnDebris(int x, int y);
+    bool isSolid(int x, int y);
+    void onHit(int i, int x, int y);
     void draw(); 
 };
 
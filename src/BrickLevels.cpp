@@ -0,0 +1,45 @@
+#include "BrickLevels.h"
+
+const BrickLevel brickLevels[] = {
+    // 1. Wall
+    brickLevel(
+        "############",
+        "############",
+        "############",
+        "............",
+        "............"),
+
+    // 2. Armour
+    brickLevel(
+        "222222222222",
+        "############",
+        "############",
+        "............",
+        "............"),
+
+    // 3. Checkerboard: every gap is a diagonal
+    brickLevel(
+        "#.#.#.#.#.#.",
+        ".#.#.#.#.#.#",
+        "#.#.#.#.#.#.",
+        ".#.#.#.#.#.#",
+        "............"),
+
+    // 4. Gates
+    brickLevel(
+        "############",
+        "#2########2#",
+        "############",
+        "XX..XXXX..XX",
+        "............"),
+
+    // 5. Fortress
+    brickLevel(
+        "..22222222..",
+        "..2######2..",
+        "..2######2..",
+        "X..........X",
+        "..XXX..XXX..")
+};
+
+const uint8_t brickLevelCount = sizeof(brickLevels) / sizeof(brickLevels[0]);
@@ -0,0 +1,79 @@
+#ifndef BRICK_LEVELS_H
+#define BRICK_LEVELS_H
+
+#include <Arduino.h>
+#include "MatrixFrame.h"
+
+// --- Compact Brick Level Format ---
+// Two bits per cell for the top BRICK_ROWS rows of the matrix, four cells
+// per byte (first cell in the low bits): 15 bytes of flash per level.
+//
+//   '.' empty   '#' brick   '2' brick that takes two hits   'X' unbreakable
+//
+// Levels are drawn like matrix art and packed at compile time; a wrong row
+// size fails a static_assert, any other character or a level with nothing
+// to break fails with a call to one of the (undefined, not constexpr)
+// functions below.
+//
+//   const BrickLevel level = brickLevel(
+//       "############",
+//       "#2########2#",
+//       "............",
+//       "XX..XXXX..XX",
+//       "............");
+
+const int BRICK_ROWS = 5;
+
+enum BrickCell : uint8_t {
+    BRICK_EMPTY = 0,
+    BRICK_NORMAL = 1,
+    BRICK_TOUGH = 2,
+    BRICK_FIXED = 3
+};
+
+struct BrickLevel {
+    static const int BYTES = (BRICK_ROWS * MatrixFrame::WIDTH) / 4;
+
+    uint8_t cells[BYTES];
+
+    BrickCell cell(int x, int y) const {
+        int i = y * MatrixFrame::WIDTH + x;
+        return (BrickCell)((pgm_read_byte(cells + (i >> 2)) >> ((i & 3) * 2)) & 3);
+    }
+};
+
+void brickLevelErrorBadCell();
+void brickLevelErrorNothingToBreak();
+
+template <size_t... N>
+constexpr BrickLevel brickLevel(const char (&... rows)[N]) {
+    static_assert(sizeof...(N) == BRICK_ROWS, "brick levels need 5 rows");
+    static_assert(((N == MatrixFrame::WIDTH + 1) && ...), "brick level rows must be 12 columns");
+
+    const char* lines[] = { rows... };
+    BrickLevel level = {};
+    int breakable = 0;
+    for (int y = 0; y < BRICK_ROWS; y++) {
+        for (int x = 0; x < MatrixFrame::WIDTH; x++) {
+            int code = 0;
+            switch (lines[y][x]) {
+                case '.': code = BRICK_EMPTY; break;
+                case '#': code = BRICK_NORMAL; break;
+                case '2': code = BRICK_TOUGH; break;
+                case 'X': code = BRICK_FIXED; break;
+                default:  brickLevelErrorBadCell();
+            }
+            if (code == BRICK_NORMAL || code == BRICK_TOUGH) breakable++;
+            int i = y * MatrixFrame::WIDTH + x;
+            level.cells[i >> 2] |= code << ((i & 3) * 2);
+        }
+    }
+    if (breakable == 0) brickLevelErrorNothingToBreak();
+    return level;
+}
+
+// --- Level Library (flash), played in order ---
+extern const BrickLevel brickLevels[];
+extern const uint8_t brickLevelCount;
+
+#endif // BRICK_LEVELS_H
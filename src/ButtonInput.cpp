@@ -0,0 +1,81 @@
+#include "ButtonInput.h"
+
+// --- Constructor ---
+ButtonInput::ButtonInput() : missed(0), count(0), published(0) {}
+
+bool ButtonInput::add(int pin) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (buttons[i].pin == pin) return true; // Shared pin (Select is also P1)
+    }
+    if (count >= MAX_BUTTONS) return false;
+
+    pinMode(pin, INPUT);
+    Button& b = buttons[count++];
+    b.pin = pin;
+    b.down = digitalRead(pin) == HIGH; // Held at boot: no PRESS until it is let go
+    b.integrator = b.down ? DEBOUNCE_MS : 0;
+    b.held = true;
+    b.downMs = millis();
+    return true;
+}
+
+// --- Scanning ---
+
+void ButtonInput::scan() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < count; i++) {
+        Button& b = buttons[i];
+        if (digitalRead(b.pin) == HIGH) {
+            if (b.integrator < DEBOUNCE_MS) b.integrator++;
+        } else {
+            if (b.integrator > 0) b.integrator--;
+        }
+
+        if (!b.down && b.integrator == DEBOUNCE_MS) {
+            b.down = true;
+            b.held = false;
+            b.downMs = now;
+            publish(b.pin, PRESS, now);
+        } else if (b.down && b.integrator == 0) {
+            b.down = false;
+            publish(b.pin, RELEASE, now);
+        } else if (b.down && !b.held && now - b.downMs >= HOLD_MS) {
+            b.held = true;
+            publish(b.pin, HOLD, now);
+        }
+    }
+}
+
+bool ButtonInput::isDown(int pin) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (buttons[i].pin == pin) return buttons[i].down;
+    }
+    return false;
+}
+
+void ButtonInput::publish(uint8_t pin, EventType type, unsigned long now) {
+    Event& e = events[published & (CAPACITY - 1)];
+    e.timeMs = now;
+    e.pin = pin;
+    e.type = type;
+    published++;
+}
+
+// --- Readers ---
+
+bool ButtonInput::Reader::pop(Event& event) {
+    if (!source || next == source->published) return false;
+
+    uint16_t behind = source->published - next;
+    if (behind > CAPACITY) {
+        source->missed += behind - CAPACITY; // Overwritten before we got here
+        next = source->published - CAPACITY;
+    }
+    event = source->events[next & (CAPACITY - 1)];
+    next++;
+    return true;
+}
+
+void ButtonInput::Reader::skip() {
+    if (source) next = source->published;
+}
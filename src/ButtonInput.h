@@ -0,0 +1,84 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+
+// --- Debounced Button Events ---
+// One service owns every button. scan() reads each pin once per input tick
+// (1 kHz) into a saturating integrator: a pin counts as pressed once it has
+// read HIGH for DEBOUNCE_MS more ticks than LOW, and released once the count
+// is back to zero, so bounce and short glitches cancel out instead of
+// restarting a timer. Changes are published as timestamped events:
+//
+//   PRESS    debounced LOW -> HIGH
+//   RELEASE  debounced HIGH -> LOW
+//   HOLD     still pressed HOLD_MS after the PRESS (once per press)
+//
+// Events go into one ring that every consumer reads through its own
+// Reader, so the sketch (menu, exit) and the running game each see every
+// event without taking them from each other. A reader that falls more than
+// CAPACITY events behind skips ahead and the gap is counted in 'missed'.
+class ButtonInput {
+public:
+    static const uint8_t MAX_BUTTONS = 4;
+    static const uint8_t CAPACITY = 16;          // Power of two
+    static const uint8_t DEBOUNCE_MS = 5;        // Integrator depth, in scans
+    static const unsigned long HOLD_MS = 600;
+
+    enum EventType : uint8_t {
+        PRESS,
+        RELEASE,
+        HOLD
+    };
+
+    struct Event {
+        unsigned long timeMs;                    // millis() when debounced
+        uint8_t pin;
+        EventType type;
+
+        bool pressed(int p) const { return type == PRESS && pin == p; }
+    };
+
+    class Reader {
+    public:
+        Reader() : source(NULL), next(0) {}
+        bool pop(Event& event);                  // Oldest unread event, false if none
+        void skip();                             // Drop everything unread
+
+    private:
+        friend class ButtonInput;
+        Reader(ButtonInput* input, uint16_t seq) : source(input), next(seq) {}
+        ButtonInput* source;
+        uint16_t next;                           // Sequence number to read
+    };
+
+    ButtonInput();
+
+    bool add(int pin);        // Watch a pin (INPUT, active HIGH); false when full
+    void scan();              // Once per input tick
+
+    bool isDown(int pin) const;                  // Debounced level
+    Reader reader() { return Reader(this, published); } // Sees events from now on
+
+    // --- Statistics ---
+    unsigned long missed;     // Events readers skipped over
+
+private:
+    struct Button {
+        uint8_t pin;
+        uint8_t integrator;   // 0..DEBOUNCE_MS
+        bool down;
+        bool held;            // HOLD already sent for this press
+        unsigned long downMs;
+    };
+
+    Button buttons[MAX_BUTTONS];
+    uint8_t count;
+
+    Event events[CAPACITY];
+    uint16_t published;       // Events ever published (wraps)
+
+    void publish(uint8_t pin, EventType type, unsigned long now);
+};
+
+#endif // BUTTON_INPUT_H
@@ -0,0 +1,30 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "LcdBuffer.h"
+#include "GlyphCache.h"
+#include "MatrixDisplay.h"
+#include "GameMusic.h"
+#include "ButtonInput.h"
+#include "PotInput.h"
+#include "InputCapture.h"
+
+// --- Console Services ---
+// Everything a game may use. The sketch owns the services for the whole
+// run. A game is built from this bundle each time it is entered (see
+// GameRegistry.h) and keeps references to what it needs.
+struct Console {
+    LcdBuffer& screen;
+    GlyphCache& glyphs;
+    MatrixDisplay& display;
+    GameMusic& music;
+    ButtonInput& buttons;
+    PotInput& pot;
+    InputCapture& playerInput;  // Timestamped P1/P2 edges
+
+    int selectPin;              // Also P1
+    int player1Pin;
+    int player2Pin;
+};
+
+#endif // CONSOLE_H
@@ -1,15 +1,62 @@
 #include "DinoGame.h"
+#include "AsciiArt.h"
+#include "Songs.h"
 
-// Constructor: Initializes the internal reference 'lcd' and 'buttonPin'
-DinoGame::DinoGame(LiquidCrystal& lcdRef, int btnPin) : lcd(lcdRef), buttonPin(btnPin) {}
+// --- Custom Characters (flash) ---
 
-void DinoGame::setup() {
-    // Create custom characters
-    lcd.createChar(0, playerChar);
-    lcd.createChar(1, obstacleChar);
+// Player standing on the bottom line of its cell
+static constexpr Glyph playerArt = glyphArt(
+    ".....",
+    ".....",
+    "...##",
+    "...##",
+    "#.##.",
+    "####.",
+    ".##..",
+    ".#.#.");
 
-    // Setup the button pin (only needs to be done once, but harmless here)
-    pinMode(buttonPin, INPUT);
+// Cactus, 2 px wide in the two left columns
+static constexpr Glyph cactusArt = glyphArt(
+    ".....",
+    ".....",
+    ".#...",
+    "##...",
+    "##...",
+    "##...",
+    "##...",
+    "##...");
+
+// The cactus 'offset' pixels into a cell; at -1 only its right column shows
+static constexpr Glyph cactusPhase(int offset) {
+    Glyph glyph = {};
+    for (int y = 0; y < 8; y++) {
+        int row = (offset < 0) ? (cactusArt.rows[y] << -offset) : (cactusArt.rows[y] >> offset);
+        glyph.rows[y] = row & 0x1F;
+    }
+    return glyph;
+}
+
+static constexpr Glyph phaseGlyphs[] = {
+    cactusPhase(-1), cactusPhase(0), cactusPhase(1), cactusPhase(2), cactusPhase(3), cactusPhase(4)
+};
+
+// Constructor: Initializes the internal references and 'buttonPin'
+DinoGame::DinoGame(const Console& console)
+    : lcd(console.screen), glyphs(console.glyphs), music(console.music), buttons(console.buttons), buttonPin(console.selectPin) {}
+
+void DinoGame::enter() {
+    // Custom characters: the whole CGRAM (no upload if still resident)
+    if (!glyphsHeld) {
+        for (int i = 0; i < PHASES; i++) phaseCode[i] = glyphs.acquire(phaseGlyphs[i]);
+        playerTop = Glyph();
+        playerBottom = Glyph();
+        playerTopCode = glyphs.acquire(playerTop);
+        playerBottomCode = glyphs.acquire(playerBottom);
+        glyphsHeld = true;
+    }
+
+    // Watch the button (only needs to be done once, but harmless here)
+    buttons.add(buttonPin);
 
     // Display introductory message
     lcd.clear();
@@ -17,69 +64,173 @@ void DinoGame::setup() {
     lcd.print(" LCD DINO GAME ");
     lcd.setCursor(0, 1);
     lcd.print(" Press to jump ");
-    delay(1000);
 
-    resetGame();
+    music.play(songPacman);
+    currentStatus = INTRO;
+    introEnd.start(INTRO_MS);
+}
+
+// Gives the glyph slots back to the cache (they stay resident until evicted)
+void DinoGame::exit() {
+    if (glyphsHeld) {
+        for (int i = 0; i < PHASES; i++) glyphs.release(phaseGlyphs[i]);
+        glyphs.forget(playerTop);    // RAM glyphs: the arena is reused
+        glyphs.forget(playerBottom);
+        glyphsHeld = false;
+    }
 }
 
 // Resets game state (position, timing)
 void DinoGame::resetGame() {
     currentStatus = PLAYING;
     jumping = false;
-    obstacleX = 15;
-    jumpStart = 0;
-    lastMove = millis();
+    jumpStep = 0;
+    speed = SPEED_START;
+    score = 0;
+    obstacleHead = 0;
+    obstacleCount = 0;
+    nextGap = 0;
+    lastStep = millis();
+    stepBacklogMs = 0;
     lcd.clear();
 }
 
-// Handles button press and jump timing
+// True if the button went down since the last tick. Holding it does not
+// repeat: every jump (or restart) takes a fresh press.
+bool DinoGame::takePress() {
+    bool pressed = false;
+    ButtonInput::Event event;
+    while (events.pop(event)) {
+        if (event.pressed(buttonPin)) pressed = true;
+    }
+    return pressed;
+}
+
+// Starts a jump on a press (the arc itself advances in step())
 void DinoGame::handleJump() {
-    // Check for jump initiation
-    // NOTE: This digitalRead must not cause the universal exit in the main loop
-    // because the main loop checks for the button press *before* calling this function.
-    if (digitalRead(buttonPin) == HIGH && !jumping) {
+    if (!jumping) {
         jumping = true;
-        jumpStart = millis();
+        jumpStep = 0;
+        music.playEffect(sfxJump);
     }
+}
+
+// Player height above the ground in pixels: a parabola over the jump
+int DinoGame::jumpHeight() const {
+    if (!jumping) return 0;
+    return 4 * JUMP_PX * jumpStep * (JUMP_STEPS - jumpStep) / (JUMP_STEPS * JUMP_STEPS);
+}
 
-    // End jump after jumpDuration
-    if (jumping && millis() - jumpStart > jumpDuration) {
-        jumping = false;
+// Spacing to the next obstacle: never shorter than one jump plus the
+// player's width, so every gap can be cleared; the slack shrinks with score
+int DinoGame::randomGap() {
+    int jumpPx = ((int32_t)JUMP_STEPS * speed) >> 8;
+    int slack = 48 - (int)score;
+    if (slack < 8) slack = 8;
+    return jumpPx + CELL_W + OBSTACLE_W + random(0, slack);
+}
+
+// New obstacle at the right edge once the newest has moved nextGap in
+void DinoGame::spawnObstacles() {
+    if (obstacleCount == MAX_OBSTACLES) return;
+    if (obstacleCount > 0) {
+        int newest = (obstacleHead + obstacleCount - 1) % MAX_OBSTACLES;
+        if ((obstacleX[newest] >> 8) > FIELD_W - nextGap) return;
     }
+    obstacleX[(obstacleHead + obstacleCount) % MAX_OBSTACLES] = FIELD_W << 8;
+    obstacleCount++;
+    nextGap = randomGap();
 }
 
-// Handles obstacle movement and respawning
-void DinoGame::moveObstacle() {
-    if (millis() - lastMove > moveInterval) {
-        obstacleX--;
-        lastMove = millis();
+// One fixed time step: scroll, clear, spawn, jump, collide
+void DinoGame::step() {
+    for (int k = 0; k < obstacleCount; k++) {
+        obstacleX[(obstacleHead + k) % MAX_OBSTACLES] -= speed;
+    }
 
-        if (obstacleX < 0) {
-            obstacleX = 15; // respawn at the right edge
-        }
+    // Oldest obstacle gone past the left edge: scored, and a little faster
+    while (obstacleCount > 0 && (obstacleX[obstacleHead] >> 8) <= -OBSTACLE_W) {
+        obstacleHead = (obstacleHead + 1) % MAX_OBSTACLES;
+        obstacleCount--;
+        score++;
+        speed += SPEED_STEP;
+        if (speed > SPEED_MAX) speed = SPEED_MAX;
+    }
+    spawnObstacles();
+
+    if (jumping && ++jumpStep >= JUMP_STEPS) jumping = false;
+
+    Glyph top, bottom;
+    if (composePlayer(top, bottom)) {
+        // Collision! Transition to GAME_OVER state
+        currentStatus = GAME_OVER;
+        music.playEffect(sfxLose);
     }
 }
 
-// Checks for collision between player (at X=1) and obstacle (at X=obstacleX)
-bool DinoGame::checkCollision() {
-    // Collision occurs if the player is on the ground (not jumping) AND the obstacle is at column 1
-    return (!jumping && obstacleX == 1);
+// Builds the player's two cells (player plus any obstacle pixels in that
+// column); true if a player pixel and an obstacle pixel overlap
+bool DinoGame::composePlayer(Glyph& top, Glyph& bottom) const {
+    top = Glyph();
+    bottom = Glyph();
+
+    int height = jumpHeight();
+    for (int y = 0; y < 8; y++) {
+        int line = 8 + y - height; // In the 16-line column
+        if (line < 0) continue;
+        if (line < 8) top.rows[line] |= playerArt.rows[y];
+        else bottom.rows[line - 8] |= playerArt.rows[y];
+    }
+
+    bool hit = false;
+    for (int k = 0; k < obstacleCount; k++) {
+        int offset = (obstacleX[(obstacleHead + k) % MAX_OBSTACLES] >> 8) - PLAYER_COL * CELL_W;
+        if (offset < -1 || offset >= CELL_W) continue;
+        const Glyph& cactus = phaseGlyphs[offset + 1];
+        for (int y = 0; y < 8; y++) {
+            if (bottom.rows[y] & cactus.rows[y]) hit = true;
+            bottom.rows[y] |= cactus.rows[y];
+        }
+    }
+    return hit;
 }
 
-// Clears the screen and redraws player and obstacle
+// Redraws the field (the shadow buffer only sends cells that changed)
 void DinoGame::draw() {
-    lcd.clear();
-
-    // Draw player: Row 0 is jump, Row 1 is ground
-    int playerRow = jumping ? 0 : 1;
-    lcd.setCursor(1, playerRow);
-    lcd.write(byte(0));
+    // Bottom row: each obstacle is one phase glyph, or two across a border
+    uint8_t ground[LcdBuffer::COLS];
+    memset(ground, ' ', sizeof(ground));
+    for (int k = 0; k < obstacleCount; k++) {
+        int x = obstacleX[(obstacleHead + k) % MAX_OBSTACLES] >> 8;
+        int cell = (x + 2 * CELL_W) / CELL_W - 2; // Rounds down for x < 0
+        int offset = x - cell * CELL_W;
+        if (cell >= 0 && cell < LcdBuffer::COLS) ground[cell] = phaseCode[offset + 1];
+        if (offset + OBSTACLE_W > CELL_W && cell + 1 >= 0 && cell + 1 < LcdBuffer::COLS) {
+            ground[cell + 1] = phaseCode[0];
+        }
+    }
 
-    // Draw obstacle (always on row 1 for this game)
-    if (obstacleX >= 0 && obstacleX < 16) {
-      lcd.setCursor(obstacleX, 1);
-      lcd.write(byte(1));
+    // Player's cells: re-upload only what changed
+    Glyph top, bottom;
+    composePlayer(top, bottom);
+    if (memcmp(&top, &playerTop, sizeof(Glyph)) != 0) {
+        playerTop = top;
+        glyphs.refresh(playerTop);
     }
+    if (memcmp(&bottom, &playerBottom, sizeof(Glyph)) != 0) {
+        playerBottom = bottom;
+        glyphs.refresh(playerBottom);
+    }
+    ground[PLAYER_COL] = playerBottomCode;
+
+    lcd.setCursor(0, 1);
+    for (int col = 0; col < LcdBuffer::COLS; col++) lcd.write(ground[col]);
+
+    // Top row: the player's head room and the score
+    lcd.setCursor(0, 0);
+    for (int col = 0; col < 12; col++) lcd.write(col == PLAYER_COL ? playerTopCode : ' ');
+    lcd.print(score);
+    lcd.print("    "); // Clipped at the edge
 }
 
 // Draws the game over message and waits for restart button press (non-blocking)
@@ -96,15 +247,31 @@ void DinoGame::drawGameOver() {
     }
 }
 
-// The main function for the game logic, called repeatedly by the Arduino loop()
-void DinoGame::run() {
+// The main function for the game logic, called every logic tick
+void DinoGame::tick() {
+    if (currentStatus == INTRO) {
+        if (!introEnd.passed()) return;
+        events = buttons.reader(); // Presses during the intro are not jumps
+        resetGame();
+        return;
+    }
+
+    bool pressed = takePress();
+
     if (currentStatus == PLAYING) {
-        handleJump();
-        moveObstacle();
+        if (pressed) handleJump();
+
+        // Elapsed time is spent in fixed steps: same game at any loop rate
+        unsigned long now = millis();
+        stepBacklogMs += now - lastStep;
+        lastStep = now;
+        if (stepBacklogMs > MAX_CATCH_UP_MS) stepBacklogMs = MAX_CATCH_UP_MS;
+        while (stepBacklogMs >= STEP_MS && currentStatus == PLAYING) {
+            stepBacklogMs -= STEP_MS;
+            step();
+        }
 
-        if (checkCollision()) {
-            // Collision! Transition to GAME_OVER state
-            currentStatus = GAME_OVER;
+        if (currentStatus == GAME_OVER) {
             // Immediate redraw to show Game Over screen
             drawGameOver();
         } else {
@@ -113,8 +280,8 @@ void DinoGame::run() {
     } else if (currentStatus == GAME_OVER) {
         drawGameOver(); // Keep refreshing the game over screen
 
-        // Check for restart via the dedicated jump button (non-blocking check)
-        if (digitalRead(buttonPin) == HIGH) {
+        // Restart on a fresh press of the jump button
+        if (pressed) {
             resetGame(); // Transitions currentStatus back to PLAYING
         }
     }
@@ -2,55 +2,107 @@
 #define DINOGAME_H
 
 #include <Arduino.h>
-#include <LiquidCrystal.h>
+#include "LcdBuffer.h"
+#include "GlyphCache.h"
+#include "GameMusic.h"
+#include "ButtonInput.h"
+#include "Game.h"
+#include "Console.h"
 
-class DinoGame {
+// --- Pixel Playfield ---
+// The 16x2 LCD is treated as an 80x16 pixel field (5x8 per cell, the gaps
+// between cells ignored). Obstacles are 2 px wide and scroll one pixel at
+// a time through six phase glyphs, one per offset -1..4 of the obstacle
+// within a cell, so a pixel step only rewrites the one or two cells it
+// touches. The player's two cells use glyphs kept in RAM and redrawn in
+// place: they show the jump arc and any obstacle passing through the
+// player's column, and are the only CGRAM uploads during play.
+class DinoGame : public Game {
 public:
-    // Internal status to manage playing/game over state
+    // Internal status to manage intro/playing/game over state
     enum GameStatus {
+        INTRO,
         PLAYING,
         GAME_OVER
     };
 
 private:
-    LiquidCrystal& lcd;
+    LcdBuffer& lcd;
+    GlyphCache& glyphs;
+    GameMusic& music;
+    ButtonInput& buttons;
+    ButtonInput::Reader events;
 
     // Pins
     const int buttonPin; // Dedicated jump button (now Pin 6, the menu select button)
 
+    // --- Field Geometry ---
+    static const int CELL_W = 5;
+    static const int FIELD_W = LcdBuffer::COLS * CELL_W; // 80 px
+    static const int PLAYER_COL = 1;                     // LCD column of the player
+    static const int OBSTACLE_W = 2;
+    static const uint8_t PHASES = CELL_W + OBSTACLE_W - 1; // Obstacle offsets -1..4
+
+    // --- Timing (fixed steps, Q8.8 pixels) ---
+    static const unsigned int STEP_MS = 16;
+    static const unsigned int MAX_CATCH_UP_MS = 100;     // Backlog kept after a stall
+    static const int16_t SPEED_START = 102;              // ~25 px/s, the old 5 cells/s
+    static const int16_t SPEED_MAX = 256;               // ~62 px/s
+    static const int16_t SPEED_STEP = 8;                // Per obstacle cleared
+
+    // --- Jump Arc: parabola over JUMP_STEPS steps, JUMP_PX high ---
+    static const int JUMP_STEPS = 56;                    // ~900 ms
+    static const int JUMP_PX = 10;
+
+    static const unsigned long INTRO_MS = 1000;
+
     // State & Timing
-    GameStatus currentStatus = PLAYING;
+    GameStatus currentStatus = INTRO;
+    Deadline introEnd;
     bool jumping = false;
-    unsigned long jumpStart = 0;
-    const unsigned long jumpDuration = 1000; // ms
+    int jumpStep = 0;
+    int16_t speed = SPEED_START;
+    unsigned int score = 0;
+    unsigned long lastStep = 0;
+    unsigned int stepBacklogMs = 0;
 
-    // Obstacle state
-    int obstacleX = 15;
-    unsigned long lastMove = 0;
-    const unsigned long moveInterval = 200; // ms (controls game speed)
+    // --- Obstacles: ring buffer, oldest first ---
+    static const uint8_t MAX_OBSTACLES = 4;
+    int16_t obstacleX[MAX_OBSTACLES];                    // Q8.8 px, left edge
+    uint8_t obstacleHead = 0;
+    uint8_t obstacleCount = 0;
+    int nextGap = 0;                                     // px from the newest to the next
 
-    // Custom characters
-    byte playerChar[8] = {
-      B11111, B11111, B11111, B11111, B11111, B11111, B11111, B11111
-    };
-    byte obstacleChar[8] = {
-      B00100, B01110, B11111, B11111, B11111, B01110, B00100, B00000
-    };
+    // Custom characters (codes handed out by the glyph cache)
+    bool glyphsHeld = false;
+    uint8_t phaseCode[PHASES];
+    uint8_t playerTopCode = 0;
+    uint8_t playerBottomCode = 0;
+    Glyph playerTop = {};                                // Animated in place
+    Glyph playerBottom = {};
 
     // Private helper methods
     void resetGame();
+    bool takePress();
     void handleJump();
-    void moveObstacle();
-    bool checkCollision();
+    void step();
+    void spawnObstacles();
+    int randomGap();
+    int jumpHeight() const;
+    bool composePlayer(Glyph& top, Glyph& bottom) const;
     void draw();
     void drawGameOver();
 
 public:
-    // Constructor now takes the button pin
-    DinoGame(LiquidCrystal& lcdRef, int btnPin);
+    static constexpr const char* MENU_NAME = "Dinossaur Jumper";
+
+    // Jumps on the select button
+    DinoGame(const Console& console);
 
-    void setup();
-    void run();
+    // --- Game ---
+    void enter() override;
+    void tick() override;
+    void exit() override;  // Cleanup on exit
 };
 
 #endif // DINOGAME_H
@@ -0,0 +1,63 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <Arduino.h>
+
+// --- Fixed-Capacity Entity Pool ---
+// Hands out slot numbers 0..N-1 from a free list: no heap, O(1) spawn and
+// despawn, and a capacity the compiler knows. The pool keeps only the
+// bookkeeping; entity data lives in the owner's arrays, one array per
+// field (structure of arrays), indexed by slot. live() is a bitmask, so an
+// update pass touches live slots only:
+//
+//   for (uint32_t m = pool.live(); m; m &= m - 1) {
+//       int i = EntityPool<N>::slot(m);
+//       x[i] += vx[i];
+//   }
+//
+// Despawning the current slot inside such a loop is safe.
+template <uint8_t N>
+class EntityPool {
+    static_assert(N > 0 && N <= 32, "EntityPool holds 1..32 slots");
+
+public:
+    static const int8_t NONE = -1;
+
+    EntityPool() { clear(); }
+
+    // Frees every slot
+    void clear() {
+        for (uint8_t i = 0; i < N; i++) next[i] = i + 1; // N = end of list
+        freeHead = 0;
+        liveMask = 0;
+    }
+
+    // A free slot, or NONE when the pool is full
+    int8_t spawn() {
+        if (freeHead >= N) return NONE;
+        uint8_t i = freeHead;
+        freeHead = next[i];
+        liveMask |= 1UL << i;
+        return i;
+    }
+
+    void despawn(int8_t i) {
+        if (!isLive(i)) return;
+        liveMask &= ~(1UL << i);
+        next[i] = freeHead;
+        freeHead = i;
+    }
+
+    bool isLive(int8_t i) const { return i >= 0 && i < N && (liveMask & (1UL << i)) != 0; }
+    uint32_t live() const { return liveMask; }
+    uint8_t count() const { return __builtin_popcount(liveMask); }
+
+    static int slot(uint32_t mask) { return __builtin_ctz(mask); } // Lowest live slot in mask
+
+private:
+    uint8_t next[N];          // Free list links
+    uint8_t freeHead;
+    uint32_t liveMask;
+};
+
+#endif // ENTITY_POOL_H
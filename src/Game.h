@@ -0,0 +1,38 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <Arduino.h>
+
+// --- Common Game Interface ---
+// The console drives every game through three calls:
+//
+//   enter()  start a session: claim glyphs and the matrix, draw the intro
+//   tick()   one logic tick (every 30 ms), never blocks
+//   exit()   give back what enter() took
+//
+// Nothing may wait inside these calls. An intro or a transition is a state
+// of its own, held for a while on a Deadline and left from tick(), so music,
+// the exit button and input keep running throughout.
+class Game {
+public:
+    virtual void enter() = 0;
+    virtual void tick() = 0;
+    virtual void exit() = 0;
+
+protected:
+    ~Game() {}                // Games are never deleted through this interface
+};
+
+// A moment on the millis() clock, for timed screens
+class Deadline {
+public:
+    Deadline() : at(0) {}
+
+    void start(unsigned long ms) { at = millis() + ms; }
+    bool passed() const { return (long)(millis() - at) >= 0; }
+
+private:
+    unsigned long at;
+};
+
+#endif // GAME_H
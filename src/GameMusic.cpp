@@ -1,96 +1,275 @@
 #include "GameMusic.h"
-
-// Pacman melody data
-const int GameMusic::pacmanMelody[] = {
-  // Pacman
-  // Score available at https://musescore.com/user/85429/scores/107109
-  NOTE_B4, 16, NOTE_B5, 16, NOTE_FS5, 16, NOTE_DS5, 16, //1
-  NOTE_B5, 32, NOTE_FS5, -16, NOTE_DS5, 8, NOTE_C5, 16,
-  NOTE_C6, 16, NOTE_G6, 16, NOTE_E6, 16, NOTE_C6, 32, NOTE_G6, -16, NOTE_E6, 8,
-
-  NOTE_B4, 16,  NOTE_B5, 16,  NOTE_FS5, 16,   NOTE_DS5, 16,  NOTE_B5, 32,  //2
-  NOTE_FS5, -16, NOTE_DS5, 8,  NOTE_DS5, 32, NOTE_E5, 32,  NOTE_F5, 32,
-  NOTE_F5, 32,  NOTE_FS5, 32,  NOTE_G5, 32,  NOTE_G5, 32, NOTE_GS5, 32,  NOTE_A5, 16, NOTE_B5, 8
-};
-
-const int GameMusic::pacmanMelodySize = sizeof(pacmanMelody) / sizeof(pacmanMelody[0]) / 2;
+#include "Profiler.h"
 
 GameMusic::GameMusic(int pin) {
   buzzerPin = pin;
-  tempo = 105; // Default tempo
-  wholenote = (60000 * 4) / tempo;
   pinMode(buzzerPin, OUTPUT);
+  timerRunning = false;
   
-  // Initialize non-blocking playback state
-  isPlaying = false;
-  currentNote = 0;
-  noteStartTime = 0;
-  currentNoteDuration = 0;
-  inPause = false;
-}
-
-void GameMusic::startPacmanIntro() {
-  isPlaying = true;
-  currentNote = 0;
-  noteStartTime = millis();
-  inPause = false;
-  
-  // Start the first note
-  if (pacmanMelodySize > 0) {
-    int divider = pacmanMelody[1];
-    if (divider > 0) {
-      currentNoteDuration = wholenote / divider;
-    } else if (divider < 0) {
-      currentNoteDuration = wholenote / abs(divider);
-      currentNoteDuration *= 1.5; // Dotted notes
+  // Initialize sequencer state
+  memset(&music, 0, sizeof(music));
+  memset(&effect, 0, sizeof(effect));
+  tempo = 0;
+  effectPriority = 0;
+  outputFrequency = 0;
+  songTicks = 0;
+  songStartUs = 0;
+  lastTickUs = 0;
+  pollUs = 0;
+
+  // Statistics (no resetStats(): interrupts are not up yet)
+  ticks = 0;
+  notesPlayed = 0;
+  effectsPlayed = 0;
+  effectsDropped = 0;
+  driftUs = 0;
+  maxDriftUs = 0;
+  maxJitterUs = 0;
+}
+
+bool GameMusic::begin() {
+  uint8_t type;
+  int8_t channel = FspTimer::get_available_timer(type);
+  if (channel < 0) return false;
+
+  if (!timer.begin(TIMER_MODE_PERIODIC, type, channel, 1000000.0f / TICK_US, 0.0f, timerCallback, this)) return false;
+  if (!timer.setup_overflow_irq() || !timer.open() || !timer.start()) return false;
+
+  timerRunning = true;
+  return true;
+}
+
+void GameMusic::timerCallback(timer_callback_args_t* args) {
+  static_cast<GameMusic*>(const_cast<void*>(args->p_context))->tick();
+}
+
+// Octave 8 (C8..B8); lower octaves halve these
+static const uint16_t octave8[12] = { 4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902 };
+
+uint16_t GameMusic::midiFrequency(uint8_t note) {
+  int shift = 9 - note / 12;
+  if (shift < 0) shift = 0;
+  uint16_t top = octave8[note % 12];
+  return (top + ((1 << shift) >> 1)) >> shift;
+}
+
+// --- Voices ---
+
+// Points a voice at the top of a song; the first note is decoded, not played
+void GameMusic::load(Voice& voice, const Song& tune, uint8_t bpm) {
+  voice.song = &tune;
+  voice.position = 0;
+  voice.bpm = bpm;
+  voice.carry = bpm / 2; // Half a tick: note ends round to the nearest tick
+  if (!nextNote(voice)) voice.song = NULL;
+}
+
+// Decodes the note at 'position'; false at the end of a song without a
+// loop point
+bool GameMusic::nextNote(Voice& voice) {
+  const Song* song = voice.song;
+  bool dotted = false;
+  for (;;) {
+    if (voice.position >= song->length) {
+      if (song->loopFrom == Song::NO_LOOP) return false;
+      voice.position = song->loopFrom;
+    }
+
+    uint8_t code = pgm_read_byte(song->data + voice.position++);
+    uint8_t lengthCode = code >> SongCode::LENGTH_SHIFT;
+    if (lengthCode == SongCode::DOT) {
+      dotted = true;
+      continue;
     }
-    
-    // Start playing the first note (90% duration)
-    tone(buzzerPin, pacmanMelody[0], currentNoteDuration * 0.9);
+    if (lengthCode > 5) continue; // Unused code
+
+    // Length in 64ths of a whole note; one 64th is 3750 / bpm ticks
+    uint16_t units = 2 << lengthCode;
+    if (dotted) units += units / 2; // Dotted notes
+    uint32_t exact = (uint32_t)units * (60000UL * 4 * 1000 / TICK_US / 64) + voice.carry;
+    uint16_t length = exact / voice.bpm;
+    voice.lead = voice.carry;
+    voice.carry = exact % voice.bpm;
+    if (length == 0) length = 1;
+    voice.noteTicks = length;
+    voice.gateTicks = length - length / 10; // 90% sound, 10% gap
+
+    uint8_t pitch = code & SongCode::PITCH_MASK;
+    voice.frequency = (pitch == 0) ? 0 : midiFrequency(song->base + pitch - 1); // 0 = rest
+    return true;
   }
 }
 
-void GameMusic::update() {
-  if (!isPlaying) return;
-  
-  unsigned long elapsed = millis() - noteStartTime;
-  
-  if (!inPause && elapsed >= (currentNoteDuration * 0.9)) {
+// Advances a voice by one tick
+GameMusic::StepResult GameMusic::step(Voice& voice) {
+  if (voice.gateTicks > 0 && --voice.gateTicks == 0) {
     // Note finished, start pause
-    noTone(buzzerPin);
-    inPause = true;
+    voice.frequency = 0;
   }
-  
-  if (inPause && elapsed >= currentNoteDuration) {
-    // Pause finished, move to next note
-    currentNote += 2; // Each note has pitch and duration
-    
-    if (currentNote >= pacmanMelodySize * 2) {
-      // Song finished, loop it
-      currentNote = 0;
-    }
-    
-    // Calculate next note duration
-    int divider = pacmanMelody[currentNote + 1];
-    if (divider > 0) {
-      currentNoteDuration = wholenote / divider;
-    } else if (divider < 0) {
-      currentNoteDuration = wholenote / abs(divider);
-      currentNoteDuration *= 1.5; // Dotted notes
+
+  if (--voice.noteTicks == 0) {
+    // Pause finished, move to next note (or loop, or stop)
+    if (!nextNote(voice)) {
+      voice.song = NULL;
+      voice.frequency = 0;
+      return STEP_END;
     }
-    
-    // Start next note
-    tone(buzzerPin, pacmanMelody[currentNote], currentNoteDuration * 0.9);
-    noteStartTime = millis();
-    inPause = false;
+    return STEP_NOTE;
+  }
+  return STEP_HOLD;
+}
+
+// Records how far a music note's onset is from the score. The exact
+// onset is off the tick grid by the fraction carried into the note.
+void GameMusic::recordOnset() {
+  long offsetUs = ((long)music.lead - music.bpm / 2) * (long)TICK_US / music.bpm;
+  long drift = (long)(micros() - songStartUs) - (long)(songTicks * TICK_US) - offsetUs;
+  unsigned long driftAbs = drift < 0 ? -drift : drift;
+  driftUs = drift;
+  if (driftAbs > maxDriftUs) maxDriftUs = driftAbs;
+  notesPlayed++;
+}
+
+// Drives the buzzer from whichever voice owns it, only when the pitch changes
+void GameMusic::output() {
+  uint16_t wanted = (effect.song != NULL) ? effect.frequency : music.frequency;
+  if (wanted == outputFrequency) return;
+  outputFrequency = wanted;
+
+  if (wanted == 0) noTone(buzzerPin);
+  else tone(buzzerPin, wanted);
+}
+
+// --- Playback ---
+
+void GameMusic::play(const Song& tune) {
+  noInterrupts();
+  tempo = tune.tempo;
+  songTicks = 0;
+  songStartUs = micros();
+  pollUs = songStartUs + TICK_US;
+  load(music, tune, tempo);
+  if (music.song != NULL) recordOnset();
+  output();
+  interrupts();
+}
+
+void GameMusic::setTempo(uint8_t bpm) {
+  if (bpm == 0) return;
+  noInterrupts();
+  tempo = bpm;
+  if (music.song != NULL) {
+    // Keep the owed fraction of a tick, rescaled to the new tempo
+    long fraction = ((long)music.carry - music.bpm / 2) * bpm / music.bpm;
+    long carry = fraction + bpm / 2;
+    if (carry < 0) carry = 0;
+    if (carry >= bpm) carry = bpm - 1;
+    music.carry = carry;
+    music.bpm = bpm;
+  }
+  interrupts();
+}
+
+bool GameMusic::playEffect(const SoundEffect& sfx) {
+  noInterrupts();
+  bool idle = (music.song == NULL && effect.song == NULL);
+  if (effect.song != NULL && sfx.priority < effectPriority) {
+    effectsDropped++;
+    interrupts();
+    return false;
+  }
+  effectPriority = sfx.priority;
+  load(effect, *sfx.song, sfx.song->tempo);
+  if (effect.song != NULL) {
+    // Restart the first note even if it has the pitch already on the buzzer
+    outputFrequency = 0xFFFF;
+    effectsPlayed++;
+  }
+  if (!timerRunning && idle) pollUs = micros() + TICK_US; // Polled fallback: start ticking now
+  interrupts();
+  return true;
+}
+
+// One sequencer step (timer callback context)
+void GameMusic::tick() {
+  PROFILE_SCOPE(Profiler::MUSIC);
+  unsigned long now = micros();
+  if (ticks > 0) {
+    long error = (long)(now - lastTickUs) - (long)TICK_US;
+    unsigned long jitter = error < 0 ? -error : error;
+    if (jitter > maxJitterUs) maxJitterUs = jitter;
+  }
+  lastTickUs = now;
+  ticks++;
+
+  if (music.song != NULL) {
+    songTicks++;
+    if (step(music) == STEP_NOTE) recordOnset();
+  }
+  if (effect.song != NULL) step(effect);
+  output();
+}
+
+void GameMusic::update() {
+  if (timerRunning) return;
+  if (music.song == NULL && effect.song == NULL && outputFrequency == 0) return;
+
+  // Step every tick that came due since the last call
+  while ((long)(micros() - pollUs) >= 0) {
+    pollUs += TICK_US;
+    tick();
   }
 }
 
 void GameMusic::stopMusic() {
-  isPlaying = false;
-  noTone(buzzerPin);
+  noInterrupts();
+  music.song = NULL;
+  music.frequency = 0;
+  effect.song = NULL;
+  effect.frequency = 0;
+  output();
+  interrupts();
 }
 
 bool GameMusic::isPlayingMusic() {
-  return isPlaying;
-}
\ No newline at end of file
+  return music.song != NULL;
+}
+
+// --- Statistics ---
+
+void GameMusic::resetStats() {
+  noInterrupts();
+  ticks = 0;
+  notesPlayed = 0;
+  effectsPlayed = 0;
+  effectsDropped = 0;
+  driftUs = 0;
+  maxDriftUs = 0;
+  maxJitterUs = 0;
+  interrupts();
+}
+
+void GameMusic::printStats(Print& out) {
+  out.print(timerRunning ? F("music (timer) ") : F("music (polled) "));
+  if (music.song != NULL) {
+    out.print(music.song->name);
+    out.print(' ');
+    out.print(tempo);
+    out.print(F(" bpm, "));
+  }
+  out.print(F("ticks "));
+  out.print(ticks);
+  out.print(F(", notes "));
+  out.print(notesPlayed);
+  out.print(F(", drift "));
+  out.print(driftUs);
+  out.print(F(" us (max "));
+  out.print(maxDriftUs);
+  out.print(F("), jitter max "));
+  out.print(maxJitterUs);
+  out.print(F(" us, sfx "));
+  out.print(effectsPlayed);
+  out.print(F(" (dropped "));
+  out.print(effectsDropped);
+  out.println(F(")"));
+}
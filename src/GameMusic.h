@@ -2,122 +2,103 @@
 #define GAMEMUSIC_H
 
 #include <Arduino.h>
+#include <FspTimer.h>
+#include "SongFormat.h"
 
-// Musical note definitions
-#define NOTE_B0  31
-#define NOTE_C1  33
-#define NOTE_CS1 35
-#define NOTE_D1  37
-#define NOTE_DS1 39
-#define NOTE_E1  41
-#define NOTE_F1  44
-#define NOTE_FS1 46
-#define NOTE_G1  49
-#define NOTE_GS1 52
-#define NOTE_A1  55
-#define NOTE_AS1 58
-#define NOTE_B1  62
-#define NOTE_C2  65
-#define NOTE_CS2 69
-#define NOTE_D2  73
-#define NOTE_DS2 78
-#define NOTE_E2  82
-#define NOTE_F2  87
-#define NOTE_FS2 93
-#define NOTE_G2  98
-#define NOTE_GS2 104
-#define NOTE_A2  110
-#define NOTE_AS2 117
-#define NOTE_B2  123
-#define NOTE_C3  131
-#define NOTE_CS3 139
-#define NOTE_D3  147
-#define NOTE_DS3 156
-#define NOTE_E3  165
-#define NOTE_F3  175
-#define NOTE_FS3 185
-#define NOTE_G3  196
-#define NOTE_GS3 208
-#define NOTE_A3  220
-#define NOTE_AS3 233
-#define NOTE_B3  247
-#define NOTE_C4  262
-#define NOTE_CS4 277
-#define NOTE_D4  294
-#define NOTE_DS4 311
-#define NOTE_E4  330
-#define NOTE_F4  349
-#define NOTE_FS4 370
-#define NOTE_G4  392
-#define NOTE_GS4 415
-#define NOTE_A4  440
-#define NOTE_AS4 466
-#define NOTE_B4  494
-#define NOTE_C5  523
-#define NOTE_CS5 554
-#define NOTE_D5  587
-#define NOTE_DS5 622
-#define NOTE_E5  659
-#define NOTE_F5  698
-#define NOTE_FS5 740
-#define NOTE_G5  784
-#define NOTE_GS5 831
-#define NOTE_A5  880
-#define NOTE_AS5 932
-#define NOTE_B5  988
-#define NOTE_C6  1047
-#define NOTE_CS6 1109
-#define NOTE_D6  1175
-#define NOTE_DS6 1245
-#define NOTE_E6  1319
-#define NOTE_F6  1397
-#define NOTE_FS6 1480
-#define NOTE_G6  1568
-#define NOTE_GS6 1661
-#define NOTE_A6  1760
-#define NOTE_AS6 1865
-#define NOTE_B6  1976
-#define NOTE_C7  2093
-#define NOTE_CS7 2217
-#define NOTE_D7  2349
-#define NOTE_DS7 2489
-#define NOTE_E7  2637
-#define NOTE_F7  2794
-#define NOTE_FS7 2960
-#define NOTE_G7  3136
-#define NOTE_GS7 3322
-#define NOTE_A7  3520
-#define NOTE_AS7 3729
-#define NOTE_B7  3951
-#define NOTE_C8  4186
-#define NOTE_CS8 4435
-#define NOTE_D8  4699
-#define NOTE_DS8 4978
-#define REST      0
-
+// --- Timer-Driven Music Sequencer ---
+// Notes are stepped from a 1 kHz hardware timer callback, so playback keeps
+// exact time whatever the game loop is doing (including delay()). Songs
+// (SongFormat.h) are decoded one byte at a time straight from flash as
+// each note starts; nothing is buffered in RAM. A whole note is
+// 240000 / tempo ticks, halved per length code below it, plus half again
+// when dotted. That is rarely a whole number of ticks, so each voice
+// carries the fraction over to the next note: every onset lands on the
+// tick nearest its exact score time and the error never adds up. Each
+// note sounds for 9/10 of its length.
+//
+// Two voices share the one buzzer. The music voice plays the game's theme;
+// the effect voice plays short sound effects and owns the buzzer while it
+// runs. The music keeps stepping underneath, so when the effect ends the
+// theme carries on from where it would be now, not where it was cut off.
+//
+// If no timer is free, begin() returns false and update() steps the same
+// ticks from the loop instead.
 class GameMusic {
+public:
+    static const unsigned long TICK_US = 1000;
+
 private:
+    // One note stream decoded from a song
+    struct Voice {
+        const Song* song;        // NULL = idle
+        uint16_t position;       // Next byte of song->data
+        uint8_t bpm;
+        uint8_t carry;           // Tick fraction owed to the next note, in 1/bpm
+        uint8_t lead;            // 'carry' when this note started, for the drift
+        uint16_t noteTicks;      // Ticks left in the current note
+        uint16_t gateTicks;      // Ticks left until the note goes silent
+        uint16_t frequency;      // What the voice wants on the buzzer, 0 = silent
+    };
+
+    enum StepResult {
+        STEP_HOLD,               // Same note as before
+        STEP_NOTE,               // A new note started
+        STEP_END                 // Song over (no loop point)
+    };
+
     int buzzerPin;
-    int tempo;
-    int wholenote;
+    FspTimer timer;
+    bool timerRunning;
     
-    // Pacman intro melody
-    static const int pacmanMelody[];
-    static const int pacmanMelodySize;
-    
-    // Non-blocking playback state
-    bool isPlaying;
-    int currentNote;
-    unsigned long noteStartTime;
-    int currentNoteDuration;
-    bool inPause;
+    // Sequencer state (touched by the timer callback)
+    Voice music;
+    Voice effect;
+    uint8_t tempo;               // Music tempo
+    uint8_t effectPriority;
+    uint16_t outputFrequency;    // What the buzzer is playing, 0 = silent
+    uint32_t songTicks;          // Ticks since the music started
+    unsigned long songStartUs;
+    unsigned long lastTickUs;
+    unsigned long pollUs;        // Fallback: next tick due (update())
+
+    static void load(Voice& voice, const Song& tune, uint8_t bpm);
+    static bool nextNote(Voice& voice);
+    static StepResult step(Voice& voice);
+    static uint16_t midiFrequency(uint8_t note);
+    void recordOnset();
+    void output();
+    void tick();
+    static void timerCallback(timer_callback_args_t* args);
 
 public:
     GameMusic(int pin);
-    void startPacmanIntro();
-    void update(); // Call this regularly to continue playback
-    void stopMusic();
+    bool begin();  // Start the sequencer timer (after the core is up)
+    void play(const Song& tune); // From the top, at the song's own tempo
+    void update(); // Fallback only: steps ticks when no timer is running
+    void stopMusic();            // Silences music and effects
     bool isPlayingMusic();
+
+    // --- Sound Effects ---
+    // Constant time and non-blocking: safe from game hot paths. Replaces a
+    // running effect of equal or lower priority; false if a higher one is
+    // still playing. The effect is heard from the next tick.
+    bool playEffect(const SoundEffect& sfx);
+    bool isPlayingEffect() const { return effect.song != NULL; }
+
+    // --- Tempo ---
+    void setTempo(uint8_t bpm);  // Until the next play(); applies from the next note
+    uint8_t getTempo() const { return tempo; }
+
+    // --- Statistics (written by the timer callback) ---
+    volatile unsigned long ticks;
+    volatile unsigned long notesPlayed;
+    volatile unsigned long effectsPlayed;
+    volatile unsigned long effectsDropped; // Refused: higher priority busy
+    volatile long driftUs;             // Last note onset minus its exact score time
+    volatile unsigned long maxDriftUs; // Worst |driftUs| since reset
+    volatile unsigned long maxJitterUs; // Worst tick interval error
+    void resetStats();
+    void printStats(Print& out);
 };
 
-#endif // GAMEMUSIC_H
\ No newline at end of file
+#endif // GAMEMUSIC_H
@@ -0,0 +1,94 @@
+#ifndef GAME_REGISTRY_H
+#define GAME_REGISTRY_H
+
+#include <Arduino.h>
+#include <new>
+#include "Game.h"
+#include "Console.h"
+#include "Profiler.h"
+
+// --- Compile-Time Game Registry ---
+// The list of game types is the menu:
+//
+//   GameRegistry<DinoGame, ReactionGame, BlockBreaker> games;
+//
+// Each type provides a 'static constexpr const char* MENU_NAME' and a
+// constructor taking a Console&. The registry generates the name table and
+// one constructor/destructor thunk per type, and builds the chosen game in
+// a single arena sized and aligned for the largest of them. Only the game
+// being played is in RAM: leaving it runs its destructor and the next game
+// reuses the space. Ticks go to the live game through one virtual call.
+template<typename... Games>
+class GameRegistry {
+public:
+    static const uint8_t COUNT = sizeof...(Games);
+    static const size_t ARENA_SIZE;
+
+    GameRegistry() : game(NULL), index(0) {
+        for (uint8_t i = 0; i < COUNT && i < Profiler::MAX_GAMES; i++) {
+            Profiler::label(Profiler::GAME + i, names[i]);
+        }
+    }
+
+    static const char* name(uint8_t i) { return i < COUNT ? names[i] : NULL; }
+
+    // --- Lifecycle ---
+    bool enter(uint8_t i, const Console& console) {
+        if (game || i >= COUNT) return false;
+        game = builders[i](arena, console);
+        index = i;
+        game->enter();
+        return true;
+    }
+
+    void tick() {
+        if (!game) return;
+        PROFILE_SCOPE(Profiler::GAME + index);
+        game->tick();
+    }
+
+    void exit() {
+        if (!game) return;
+        game->exit();
+        destroyers[index](game);
+        game = NULL;
+    }
+
+    bool running() const { return game != NULL; }
+
+private:
+    template<typename T>
+    static Game* build(void* where, const Console& console) { return new (where) T(console); }
+
+    template<typename T>
+    static void destroy(Game* g) { static_cast<T*>(g)->~T(); }
+
+    static constexpr size_t largest(size_t a) { return a; }
+    template<typename... Rest>
+    static constexpr size_t largest(size_t a, size_t b, Rest... rest) { return largest(a > b ? a : b, rest...); }
+
+    typedef Game* (*Builder)(void*, const Console&);
+    typedef void (*Destroyer)(Game*);
+
+    static const char* const names[COUNT];
+    static const Builder builders[COUNT];
+    static const Destroyer destroyers[COUNT];
+
+    alignas(Games...) uint8_t arena[largest(sizeof(Games)...)];
+    Game* game;               // Lives in arena, NULL = none
+    uint8_t index;
+};
+
+template<typename... Games>
+const size_t GameRegistry<Games...>::ARENA_SIZE = GameRegistry<Games...>::largest(sizeof(Games)...);
+
+template<typename... Games>
+const char* const GameRegistry<Games...>::names[COUNT] = { Games::MENU_NAME... };
+
+template<typename... Games>
+const typename GameRegistry<Games...>::Builder GameRegistry<Games...>::builders[COUNT] = { &GameRegistry<Games...>::template build<Games>... };
+
+template<typename... Games>
+const typename GameRegistry<Games...>::Destroyer GameRegistry<Games...>::destroyers[COUNT] = { &GameRegistry<Games...>::template destroy<Games>... };
+
+#endif // GAME_REGISTRY_H
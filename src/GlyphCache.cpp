@@ -0,0 +1,100 @@
+#include "GlyphCache.h"
+
+// --- Constructor ---
+GlyphCache::GlyphCache(LcdBuffer& lcdRef)
+    : hits(0), uploads(0), evictions(0), lcd(lcdRef), useClock(0) {
+    for (int i = 0; i < SLOTS; i++) {
+        slots[i].glyph = NULL;
+        slots[i].refs = 0;
+        slots[i].lastUse = 0;
+    }
+}
+
+// --- Allocation ---
+
+uint8_t GlyphCache::acquire(const Glyph& glyph) {
+    useClock++;
+
+    // 1. Already resident: no upload
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].glyph == &glyph) {
+            slots[i].refs++;
+            slots[i].lastUse = useClock;
+            hits++;
+            return i;
+        }
+    }
+
+    // 2. Empty slot, else the least recently used unreferenced one
+    int victim = -1;
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].glyph == NULL) {
+            victim = i;
+            break;
+        }
+        if (slots[i].refs == 0 && (victim < 0 || slots[i].lastUse < slots[victim].lastUse)) {
+            victim = i;
+        }
+    }
+    if (victim < 0) return FALLBACK_CHAR;
+
+    if (slots[victim].glyph != NULL) evictions++;
+    slots[victim].glyph = &glyph;
+    slots[victim].refs = 1;
+    slots[victim].lastUse = useClock;
+
+    lcd.createChar(victim, glyph.rows);
+    uploads++;
+    return victim;
+}
+
+void GlyphCache::refresh(const Glyph& glyph) {
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].glyph == &glyph) {
+            // Cells showing this code change on the glass with no DDRAM write
+            lcd.createChar(i, glyph.rows);
+            uploads++;
+            return;
+        }
+    }
+}
+
+void GlyphCache::release(const Glyph& glyph) {
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].glyph == &glyph) {
+            // Stays resident for the next acquire until something evicts it
+            if (slots[i].refs > 0) slots[i].refs--;
+            return;
+        }
+    }
+}
+
+void GlyphCache::forget(const Glyph& glyph) {
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].glyph == &glyph) {
+            if (slots[i].refs > 0) slots[i].refs--;
+            // Last holder gone: free the slot so the address can't hit again
+            if (slots[i].refs == 0) slots[i].glyph = NULL;
+            return;
+        }
+    }
+}
+
+// --- Statistics ---
+
+void GlyphCache::printStats(Print& out) const {
+    int held = 0;
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].refs > 0) held++;
+    }
+    out.print(F("glyphs held "));
+    out.print(held);
+    out.print('/');
+    out.print(SLOTS);
+    out.print(F(", hits "));
+    out.print(hits);
+    out.print(F(", uploads "));
+    out.print(uploads);
+    out.print(F(", evictions "));
+    out.println(evictions);
+}
@@ -0,0 +1,53 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+#include "LcdBuffer.h"
+
+// --- Custom Character Bitmap ---
+// Eight 5-bit rows. Define glyphs as constexpr so they live in flash; the
+// cache identifies a glyph by its address. A glyph in RAM can be animated
+// in place: change its rows, then refresh() it. Before a RAM glyph goes
+// away, forget() it, or a later object at the same address would be
+// taken for it.
+struct Glyph {
+    uint8_t rows[8];
+};
+
+// --- CGRAM Slot Manager ---
+// The HD44780 has 8 custom character slots. Games ask for glyphs instead
+// of owning slot numbers: a glyph that is already resident is reused
+// without touching the bus, otherwise it goes into a free slot or replaces
+// the least recently used glyph nobody holds.
+class GlyphCache {
+public:
+    static const int SLOTS = 8;
+    static const uint8_t FALLBACK_CHAR = 0xFF; // Solid block in the LCD ROM
+
+    GlyphCache(LcdBuffer& lcdRef);
+
+    // Character code to print for 'glyph' (FALLBACK_CHAR if all slots are held)
+    uint8_t acquire(const Glyph& glyph);
+    void release(const Glyph& glyph);
+    void forget(const Glyph& glyph);    // Release and drop the address key
+    void refresh(const Glyph& glyph);   // Re-upload a resident glyph that changed
+
+    // --- Statistics ---
+    unsigned long hits;
+    unsigned long uploads;
+    unsigned long evictions;
+    void printStats(Print& out) const;
+
+private:
+    struct Slot {
+        const Glyph* glyph;             // NULL = empty
+        uint8_t refs;
+        unsigned long lastUse;
+    };
+
+    LcdBuffer& lcd;
+    Slot slots[SLOTS];
+    unsigned long useClock;
+};
+
+#endif // GLYPH_CACHE_H
@@ -0,0 +1,133 @@
+#include "InputCapture.h"
+
+InputCapture* InputCapture::instance = NULL;
+
+// UNO R4 pins documented for attachInterrupt(). The core maps every pin to
+// itself in digitalPinToInterrupt(), so that alone cannot tell us.
+static const uint8_t irqPins[] = { 2, 3 };
+
+// --- Constructor ---
+InputCapture::InputCapture(int pin0, int pin1)
+    : overflows(0), recording(false), pinInterrupts(false), timerRunning(false), head(0), tail(0) {
+    pins[0] = pin0;
+    pins[1] = pin1;
+    level[0] = level[1] = false;
+}
+
+bool InputCapture::hasInterrupt(int pin) {
+    if (digitalPinToInterrupt(pin) == NOT_AN_INTERRUPT) return false;
+    for (unsigned int i = 0; i < sizeof(irqPins); i++) {
+        if (irqPins[i] == pin) return true;
+    }
+    return false;
+}
+
+bool InputCapture::begin() {
+    instance = this;
+    for (int c = 0; c < CHANNELS; c++) {
+        pinMode(pins[c], INPUT);
+        level[c] = digitalRead(pins[c]) == HIGH;
+    }
+
+    // 1. Both pins on interrupt lines: stamp each edge as it happens
+    if (hasInterrupt(pins[0]) && hasInterrupt(pins[1])) {
+        attachInterrupt(digitalPinToInterrupt(pins[0]), pin0Isr, CHANGE);
+        attachInterrupt(digitalPinToInterrupt(pins[1]), pin1Isr, CHANGE);
+        pinInterrupts = true;
+        return true;
+    }
+
+    // 2. Otherwise sample both from one timer, so neither pin is favoured
+    uint8_t type;
+    int8_t channel = FspTimer::get_available_timer(type);
+    if (channel < 0) return false;
+    if (!timer.begin(TIMER_MODE_PERIODIC, type, channel, 1000000.0f / SAMPLE_US, 0.0f, sampleCallback, this)) return false;
+    timerRunning = timer.setup_overflow_irq() && timer.open() && timer.start();
+    return timerRunning;
+}
+
+// --- Producer (interrupt context) ---
+
+void InputCapture::pin0Isr() {
+    if (instance) instance->pinChanged(0);
+}
+
+void InputCapture::pin1Isr() {
+    if (instance) instance->pinChanged(1);
+}
+
+void InputCapture::sampleCallback(timer_callback_args_t* args) {
+    static_cast<InputCapture*>(const_cast<void*>(args->p_context))->sample();
+}
+
+void InputCapture::pinChanged(uint8_t channel) {
+    unsigned long now = micros();
+    bool high = digitalRead(pins[channel]) == HIGH;
+    if (high == level[channel]) return; // Bounced back before we looked
+    level[channel] = high;
+    record(channel, high, now);
+}
+
+void InputCapture::sample() {
+    unsigned long now = micros(); // One stamp for the whole sample
+    for (uint8_t c = 0; c < CHANNELS; c++) {
+        bool high = digitalRead(pins[c]) == HIGH;
+        if (high == level[c]) continue;
+        level[c] = high;
+        record(c, high, now);
+    }
+}
+
+void InputCapture::record(uint8_t channel, bool high, unsigned long timeUs) {
+    if (!recording) return;
+    uint8_t h = head;
+    uint8_t next = (h + 1) & (CAPACITY - 1);
+    if (next == tail) {
+        overflows++;
+        return;
+    }
+    edgeTime[h] = timeUs;
+    edgeCode[h] = channel | (high ? 0x80 : 0);
+    head = next; // Publish only once the slot is written
+}
+
+// --- Consumer (loop) ---
+
+void InputCapture::start() {
+    clear();
+    recording = true;
+}
+
+void InputCapture::stop() {
+    recording = false;
+}
+
+void InputCapture::clear() {
+    tail = head;
+}
+
+bool InputCapture::peek(Edge& edge) const {
+    uint8_t t = tail;
+    if (t == head) return false;
+    edge.timeUs = edgeTime[t];
+    edge.channel = edgeCode[t] & 0x7F;
+    edge.pressed = (edgeCode[t] & 0x80) != 0;
+    return true;
+}
+
+bool InputCapture::pop(Edge& edge) {
+    if (!peek(edge)) return false;
+    tail = (tail + 1) & (CAPACITY - 1); // Hand the slot back
+    return true;
+}
+
+// --- Statistics ---
+
+void InputCapture::printStats(Print& out) const {
+    out.print(F("capture "));
+    if (pinInterrupts) out.print(F("(pin interrupts)"));
+    else if (timerRunning) out.print(F("(1 kHz timer)"));
+    else out.print(F("(off: no timer)"));
+    out.print(F(", overflows "));
+    out.println(overflows);
+}
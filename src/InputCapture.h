@@ -0,0 +1,71 @@
+#ifndef INPUT_CAPTURE_H
+#define INPUT_CAPTURE_H
+
+#include <Arduino.h>
+#include "FspTimer.h"
+
+// --- Timestamped Button Edges ---
+// Records every press and release on two pins with its micros() time,
+// from interrupt context, so the game loop can tell who was first however
+// late it gets around to looking. If both pins have an external interrupt
+// line, each edge is stamped in its own ISR (a few us). Otherwise both are
+// sampled by a 1 kHz timer: edges land up to 1 ms late, equally for both
+// pins, and edges caught in the same sample share a timestamp (a tie).
+//
+// Edges pass through a single-producer, single-consumer ring: interrupt
+// code only writes 'head', the loop only writes 'tail', so neither side
+// ever masks interrupts. The two pin ISRs share one priority and never
+// nest, so together they are still a single producer.
+class InputCapture {
+public:
+    static const uint8_t CHANNELS = 2;
+    static const uint8_t CAPACITY = 16;         // Power of two
+    static const unsigned long SAMPLE_US = 1000; // Timer fallback period
+
+    struct Edge {
+        unsigned long timeUs;
+        uint8_t channel;                        // 0 or 1, in constructor order
+        bool pressed;                           // true = went HIGH
+    };
+
+    InputCapture(int pin0, int pin1);
+
+    bool begin();             // Interrupts or sampler; false if neither is available
+
+    // --- Recording ---
+    void start();             // Record from now on (drops anything queued)
+    void stop();
+    bool peek(Edge& edge) const; // Oldest unread edge, left in the ring
+    bool pop(Edge& edge);     // Oldest unread edge, false if none
+    void clear();             // Drop unread edges
+
+    // --- Statistics ---
+    unsigned long overflows;  // Edges lost to a full ring
+    void printStats(Print& out) const;
+
+private:
+    int pins[CHANNELS];
+    volatile bool level[CHANNELS];             // Last level seen per pin
+    volatile bool recording;
+    bool pinInterrupts;
+    bool timerRunning;
+    FspTimer timer;
+
+    // Ring: producer owns head, consumer owns tail
+    volatile unsigned long edgeTime[CAPACITY];
+    volatile uint8_t edgeCode[CAPACITY];        // Channel, bit 7 = pressed
+    volatile uint8_t head;
+    volatile uint8_t tail;
+
+    static InputCapture* instance;              // For the pin ISRs
+    static bool hasInterrupt(int pin);
+    static void pin0Isr();
+    static void pin1Isr();
+    static void sampleCallback(timer_callback_args_t* args);
+
+    void pinChanged(uint8_t channel);
+    void sample();
+    void record(uint8_t channel, bool high, unsigned long timeUs);
+};
+
+#endif // INPUT_CAPTURE_H
@@ -0,0 +1,269 @@
+#include "LcdBuffer.h"
+#include "TextLayout.h"
+
+// --- Constructor ---
+LcdBuffer::LcdBuffer(LcdQueue& queue)
+    : bytesSent(0), flushes(0), deferred(0), shifts(0), out(queue),
+      cgramPending(0), shift(0), lcdAddr(-1), cursorCol(0), cursorRow(0), dirty(false) {
+    memset(back, ' ', sizeof(back));
+    memset(ddram, ' ', sizeof(ddram));
+    memset(strips, 0, sizeof(strips));
+}
+
+// --- Initialization ---
+
+void LcdBuffer::begin() {
+    // One real clear so the shadow copy starts out matching the glass
+    // (it also resets the display shift)
+    out.command(LCD_CLEARDISPLAY);
+    out.drain();
+    bytesSent++;
+    memset(back, ' ', sizeof(back));
+    memset(ddram, ' ', sizeof(ddram));
+    memset(strips, 0, sizeof(strips));
+    shift = 0;
+    lcdAddr = -1;
+    cursorCol = cursorRow = 0;
+    dirty = false;
+}
+
+// --- Drawing ---
+
+void LcdBuffer::clear() {
+    memset(back, ' ', sizeof(back));
+    memset(strips, 0, sizeof(strips));
+    cursorCol = cursorRow = 0;
+    dirty = true;
+}
+
+void LcdBuffer::setCursor(uint8_t col, uint8_t row) {
+    cursorCol = col;
+    cursorRow = (row < ROWS) ? row : ROWS - 1;
+}
+
+size_t LcdBuffer::write(uint8_t c) {
+    // Text past the right edge is clipped, as it is on the 16x2 glass
+    if (cursorCol < COLS) {
+        if (back[cursorRow][cursorCol] != (char)c) {
+            back[cursorRow][cursorCol] = c;
+            dirty = true;
+        }
+    }
+    if (cursorCol < 255) cursorCol++;
+    return 1;
+}
+
+uint8_t LcdBuffer::stripPeriod(int len) {
+    // Divisors of 40: the loop must tile the DDRAM row exactly
+    static const uint8_t periods[] = { 5, 8, 10, 20, 40 };
+    for (uint8_t i = 0; i < sizeof(periods); i++) {
+        if (periods[i] >= len + 1) return periods[i];
+    }
+    return 0;
+}
+
+char LcdBuffer::stripChar(const Strip& s, unsigned int index) {
+    index %= s.period;
+    return (index < s.len) ? s.text[index] : ' ';
+}
+
+void LcdBuffer::printStrip(uint8_t row, uint8_t col, uint8_t width, const char* text, unsigned int offset) {
+    if (row >= ROWS) return;
+    int len = strlen(text);
+    uint8_t period = stripPeriod(len);
+
+    setCursor(col, row);
+    if (len <= width || period == 0) {
+        // Fits (or too long to tile DDRAM): ordinary text
+        strips[row].text = NULL;
+        printMarquee(*this, text, width, offset);
+        return;
+    }
+
+    Strip& s = strips[row];
+    if (s.text != text || s.offset != offset || s.col != col || s.width != width) dirty = true;
+    s.text = text;
+    s.offset = offset;
+    s.len = len;
+    s.col = col;
+    s.width = width;
+    s.period = period;
+
+    for (int i = 0; i < width; i++) {
+        write((uint8_t)stripChar(s, offset + i));
+    }
+}
+
+void LcdBuffer::createChar(uint8_t location, const uint8_t charmap[]) {
+    location &= 0x7;
+    memcpy(cgram[location], charmap, 8);
+    cgramPending |= 1 << location;
+    dirty = true;
+}
+
+// --- Output ---
+
+bool LcdBuffer::changed(int row, int col, uint8_t atShift) const {
+    int a = (col + atShift) % DDRAM_COLS;
+    return back[row][col] != ddram[row][a];
+}
+
+// Bytes needed to make the glass match at a given shift (one setCursor per run)
+int LcdBuffer::diffCost(uint8_t atShift) const {
+    int cost = 0;
+    for (int row = 0; row < ROWS; row++) {
+        bool inRun = false;
+        for (int col = 0; col < COLS; col++) {
+            bool diff = changed(row, col, atShift);
+            if (diff) cost += inRun ? 1 : 2;
+            inRun = diff && (col + atShift) % DDRAM_COLS != DDRAM_COLS - 1;
+        }
+    }
+    return cost;
+}
+
+// Queues 'count' bytes at one DDRAM position; false if the queue is full
+bool LcdBuffer::writeRun(int row, int ddramCol, const char* chars, int count) {
+    int addr = (row == 0 ? 0x00 : 0x40) + ddramCol;
+    bool needCursor = (lcdAddr != addr);
+    if (out.space() < count + (needCursor ? 1 : 0)) return false;
+
+    if (needCursor) {
+        out.command(LCD_SETDDRAMADDR | addr);
+        bytesSent++;
+    }
+    for (int i = 0; i < count; i++) {
+        out.data((uint8_t)chars[i]);
+        ddram[row][ddramCol + i] = chars[i];
+        bytesSent++;
+    }
+
+    // Running off the end of a DDRAM row wraps to the other row's start
+    lcdAddr = (ddramCol + count < DDRAM_COLS) ? addr + count : -1;
+    return true;
+}
+
+// Sends pending glyphs whole (9 bytes each); false if the queue filled first
+bool LcdBuffer::uploadGlyphs() {
+    for (uint8_t slot = 0; cgramPending != 0 && slot < 8; slot++) {
+        if (!(cgramPending & (1 << slot))) continue;
+        if (out.space() < 9) return false;
+
+        out.command(LCD_SETCGRAMADDR | (slot << 3));
+        for (int i = 0; i < 8; i++) {
+            out.data(cgram[slot][i]);
+        }
+        bytesSent += 9;
+        cgramPending &= ~(1 << slot);
+        lcdAddr = -1; // The controller is now addressing CGRAM
+    }
+    return true;
+}
+
+// Writes each strip's upcoming characters into the columns outside the
+// window at 'atShift', laid out so later steps at the same phase need none
+void LcdBuffer::prefillStrips(uint8_t atShift) {
+    for (int row = 0; row < ROWS; row++) {
+        const Strip& s = strips[row];
+        if (s.text == NULL) continue;
+
+        char run[DDRAM_COLS];
+        int runStart = -1, runLen = 0;
+        for (int a = 0; a <= DDRAM_COLS; a++) {
+            bool need = false;
+            char c = ' ';
+            if (a < DDRAM_COLS) {
+                // Screen column this cell will show at, counting from the window start
+                int screenCol = (a - atShift + DDRAM_COLS) % DDRAM_COLS;
+                // Cells still on the glass wait until the shift has moved them off
+                bool visible = (a - shift + DDRAM_COLS) % DDRAM_COLS < COLS;
+                if (screenCol >= COLS && !visible) {
+                    c = stripChar(s, s.offset + screenCol - s.col);
+                    need = (ddram[row][a] != c);
+                }
+            }
+            if (need) {
+                if (runLen == 0) runStart = a;
+                run[runLen++] = c;
+            } else if (runLen > 0) {
+                if (!writeRun(row, runStart, run, runLen)) return;
+                runLen = 0;
+            }
+        }
+    }
+}
+
+void LcdBuffer::flush() {
+    if (!dirty) return;
+    flushes++;
+
+    // 0. Glyphs first: cells drawn below may already use them
+    if (!uploadGlyphs()) {
+        deferred++;
+        return;
+    }
+
+    // 1. Scroll strips with one shift command when that beats rewriting.
+    // Only then are the off-screen columns prefilled: a step that is not
+    // shifted would have to lay them out all over again.
+    if (strips[0].text != NULL || strips[1].text != NULL) {
+        uint8_t next = (shift + 1) % DDRAM_COLS;
+        if (diffCost(next) + 1 < diffCost(shift) && out.space() > 0) {
+            prefillStrips(next);
+            if (out.space() == 0) {
+                deferred++;
+                return;
+            }
+            out.command(LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT);
+            shift = next;
+            shifts++;
+            bytesSent++;
+        }
+    }
+
+    // 2. Cell diff against display memory at the current shift
+    for (int row = 0; row < ROWS; row++) {
+        int col = 0;
+        while (col < COLS) {
+            if (!changed(row, col, shift)) {
+                col++;
+                continue;
+            }
+
+            // Extend over neighbouring changes that are also DDRAM neighbours
+            int a = (col + shift) % DDRAM_COLS;
+            int end = col;
+            while (end + 1 < COLS && changed(row, end + 1, shift) && a + (end - col) < DDRAM_COLS - 1) end++;
+
+            // Back-pressure: send what fits, the rest stays dirty
+            int count = end - col + 1;
+            int room = out.space() - 1;
+            if (room <= 0) {
+                deferred++;
+                return;
+            }
+            if (count > room) count = room;
+
+            if (!writeRun(row, a, &back[row][col], count)) {
+                deferred++;
+                return;
+            }
+            col += count;
+        }
+    }
+
+    dirty = false;
+}
+
+// --- Statistics ---
+
+void LcdBuffer::printStats(Print& out) const {
+    out.print(F("lcd buffer flushes "));
+    out.print(flushes);
+    out.print(F(" (deferred "));
+    out.print(deferred);
+    out.print(F("), queued "));
+    out.print(bytesSent);
+    out.print(F(" B, shifts "));
+    out.println(shifts);
+}
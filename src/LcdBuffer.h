@@ -0,0 +1,91 @@
+#ifndef LCD_BUFFER_H
+#define LCD_BUFFER_H
+
+#include <Arduino.h>
+#include "LcdQueue.h"
+
+// --- Shadow Framebuffer for the 16x2 LCD ---
+// Drawing calls (clear/setCursor/print/write) only touch RAM. flush()
+// compares the back buffer against a copy of the controller's display
+// memory and queues just the changed cells, one setCursor per run of
+// neighbouring changes. clear() is free: it never sends the slow HD44780
+// clear command. When the LcdQueue is full, flush() stops early and
+// resumes next call.
+//
+// The HD44780 keeps 40 columns per row and shows a 16-column window that
+// the display-shift command slides in one byte. printStrip() marks a
+// marquee whose loop length divides 40: its upcoming characters are
+// written once into the off-screen columns, and each scroll step becomes a
+// single shift command whenever that is cheaper than rewriting the cells.
+// Static cells are re-placed by the normal diff after every shift.
+//
+// Custom characters are shadowed too: createChar() only stores the bitmap,
+// and flush() uploads pending glyphs ahead of the cells, so a cell never
+// shows a glyph before its new bitmap is in CGRAM.
+class LcdBuffer : public Print {
+public:
+    static const int COLS = 16;
+    static const int ROWS = 2;
+    static const int DDRAM_COLS = 40;
+
+    LcdBuffer(LcdQueue& queue);
+
+    void begin();                // Call once after lcd.begin(), blocks
+
+    // --- Drawing (RAM only) ---
+    void clear();
+    void setCursor(uint8_t col, uint8_t row);
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // Marquee of 'text' in cells col..col+width-1 at scroll 'offset'.
+    // Loops with the shortest gap that makes the loop divide 40 columns.
+    void printStrip(uint8_t row, uint8_t col, uint8_t width, const char* text, unsigned int offset);
+
+    // Custom characters: uploaded by the next flush (latest bitmap wins)
+    void createChar(uint8_t location, const uint8_t charmap[]);
+
+    // --- Output ---
+    void flush() override;       // Queue changed cells for the LCD
+
+    // --- Statistics ---
+    unsigned long bytesSent;     // Commands + data bytes queued for the bus
+    unsigned long flushes;
+    unsigned long deferred;      // Flushes cut short by a full queue
+    unsigned long shifts;        // Scroll steps done with one shift command
+    void printStats(Print& out) const;
+
+private:
+    struct Strip {
+        const char* text;        // NULL = no strip on this row
+        unsigned int offset;
+        uint8_t len;
+        uint8_t col;
+        uint8_t width;
+        uint8_t period;          // len + gap, always a divisor of 40
+    };
+
+    LcdQueue& out;
+
+    char back[ROWS][COLS];               // What we want on screen
+    char ddram[ROWS][DDRAM_COLS];        // What the controller holds
+    Strip strips[ROWS];
+    uint8_t cgram[8][8];                 // Glyph bitmaps awaiting upload
+    uint8_t cgramPending;                // Bit per CGRAM slot
+
+    uint8_t shift;                       // Display shift, 0..39
+    int16_t lcdAddr;                     // Controller DDRAM address, -1 = unknown
+    uint8_t cursorCol, cursorRow;
+    bool dirty;
+
+    static uint8_t stripPeriod(int len);
+    static char stripChar(const Strip& s, unsigned int index);
+
+    bool changed(int row, int col, uint8_t atShift) const;
+    int diffCost(uint8_t atShift) const;
+    bool uploadGlyphs();
+    void prefillStrips(uint8_t atShift);
+    bool writeRun(int row, int ddramCol, const char* chars, int count);
+};
+
+#endif // LCD_BUFFER_H
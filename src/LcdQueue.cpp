@@ -0,0 +1,73 @@
+#include "LcdQueue.h"
+#include "Profiler.h"
+
+// --- Constructor ---
+LcdQueue::LcdQueue(LiquidCrystal& lcdRef)
+    : bytesSent(0), rejected(0), highWater(0), lcd(lcdRef), head(0), tail(0) {}
+
+// --- Producer Side ---
+
+bool LcdQueue::push(uint16_t entry) {
+    if (space() == 0) {
+        rejected++;
+        return false;
+    }
+    ring[head & (CAPACITY - 1)] = entry;
+    head++;
+
+    int used = (int)(head - tail);
+    if (used > highWater) highWater = used;
+    return true;
+}
+
+bool LcdQueue::command(uint8_t value) {
+    return push(value);
+}
+
+bool LcdQueue::data(uint8_t value) {
+    return push(0x100 | value);
+}
+
+// --- Consumer Side ---
+
+void LcdQueue::sendOne() {
+    if (idle()) return;
+
+    uint16_t entry = ring[tail & (CAPACITY - 1)];
+    tail++;
+
+    if (entry & 0x100) {
+        lcd.write((uint8_t)entry);
+    } else {
+        lcd.command((uint8_t)entry);
+    }
+    bytesSent++;
+}
+
+void LcdQueue::pump(unsigned long budgetUs) {
+    PROFILE_SCOPE(Profiler::LCD);
+    unsigned long start = micros();
+    // Always make progress, then keep going while the budget lasts
+    do {
+        sendOne();
+    } while (!idle() && micros() - start < budgetUs);
+}
+
+void LcdQueue::drain() {
+    while (!idle()) {
+        sendOne();
+    }
+}
+
+// --- Statistics ---
+
+void LcdQueue::printStats(Print& out) const {
+    out.print(F("lcd queue sent "));
+    out.print(bytesSent);
+    out.print(F(" B, high water "));
+    out.print(highWater);
+    out.print('/');
+    out.print(CAPACITY);
+    out.print(F(", rejected "));
+    out.println(rejected);
+}
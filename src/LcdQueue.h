@@ -0,0 +1,47 @@
+#ifndef LCD_QUEUE_H
+#define LCD_QUEUE_H
+
+#include <Arduino.h>
+#include <LiquidCrystal.h>
+
+// --- Queued LCD Driver ---
+// Every LiquidCrystal byte blocks for the whole 4-bit transfer (~0.2 ms).
+// Drawing code never talks to the panel directly: bytes are queued here and
+// pump() drains them a few at a time within a microsecond budget, so one
+// big redraw is spread over several scheduler ticks instead of stalling
+// input and physics.
+class LcdQueue {
+public:
+    static const int CAPACITY = 64;      // Power of two
+
+    LcdQueue(LiquidCrystal& lcdRef);
+
+    // --- Producer Side ---
+    bool command(uint8_t value);         // false if the queue is full
+    bool data(uint8_t value);
+    int space() const { return CAPACITY - (int)(head - tail); }
+
+    // --- Consumer Side ---
+    void pump(unsigned long budgetUs);   // Call from a scheduler task
+    void drain();                        // Barrier: blocks until everything is on the glass
+    bool idle() const { return head == tail; }
+
+    // --- Statistics ---
+    unsigned long bytesSent;
+    unsigned long rejected;              // Pushes refused because the queue was full
+    int highWater;
+    void printStats(Print& out) const;
+
+private:
+    LiquidCrystal& lcd;
+
+    // Entry: low byte = value, bit 8 = data (RS high)
+    uint16_t ring[CAPACITY];
+    uint16_t head;                       // Next free slot (producer)
+    uint16_t tail;                       // Next entry to send (consumer)
+
+    bool push(uint16_t entry);
+    void sendOne();
+};
+
+#endif // LCD_QUEUE_H
@@ -0,0 +1,74 @@
+#include "MatrixDisplay.h"
+#include "Profiler.h"
+
+// --- Constructor ---
+MatrixDisplay::MatrixDisplay()
+    : swaps(0), output(matrix), backIndex(0), pending(false), shownSwap(0), shownUs(0), holder(NULL) {
+}
+
+void MatrixDisplay::begin() {
+    matrix.begin();
+    reset();
+}
+
+// --- Lease ---
+
+bool MatrixDisplay::lease(const void* owner) {
+    if (holder != NULL && holder != owner) return false;
+    holder = owner;
+    return true;
+}
+
+void MatrixDisplay::reset() {
+    holder = NULL;
+    frames[0].clear();
+    frames[1].clear();
+    pending = true;
+    update(); // Blank now, not at the next render
+}
+
+// --- Drawing ---
+
+void MatrixDisplay::present(const void* owner) {
+    if (owner != holder) return;
+
+    backIndex ^= 1;
+    // New back starts as a copy, so games can draw incrementally
+    frames[backIndex] = frames[backIndex ^ 1];
+    pending = true;
+    swaps++;
+}
+
+void MatrixDisplay::show(const void* owner, const MatrixFrame& frame) {
+    if (owner != holder) return;
+    back() = frame;
+    present(owner);
+}
+
+// --- Output ---
+
+void MatrixDisplay::update() {
+    if (!pending) return;
+    PROFILE_SCOPE(Profiler::MATRIX);
+    output.push(front());
+    pending = false;
+    shownSwap = swaps;
+    shownUs = micros();
+}
+
+bool MatrixDisplay::shownAt(unsigned long swap, unsigned long& us) const {
+    if ((long)(shownSwap - swap) < 0) return false;
+    us = shownUs;
+    return true;
+}
+
+// --- Statistics ---
+
+void MatrixDisplay::printStats(Print& out) const {
+    out.print(F("matrix swaps "));
+    out.print(swaps);
+    out.print(F(", pushed "));
+    out.print(output.pushCount());
+    out.print(F(", skipped unchanged "));
+    out.println(output.skipCount());
+}
@@ -0,0 +1,56 @@
+#ifndef MATRIX_DISPLAY_H
+#define MATRIX_DISPLAY_H
+
+#include <Arduino.h>
+#include "Arduino_LED_Matrix.h"
+#include "MatrixFrame.h"
+
+// --- Shared LED Matrix Display Service ---
+// The console owns the one ArduinoLEDMatrix; games borrow it with a lease.
+// Drawing goes into the back frame, present() swaps it to the front in one
+// index flip at the end of a game frame, and update() hands the finished
+// front frame to the driver. The driver never sees a half-drawn frame.
+//
+// Only the lease holder can present. reset() drops the lease and blanks
+// the glass, so leaving a game is one call whatever was on screen.
+class MatrixDisplay {
+public:
+    MatrixDisplay();
+
+    void begin();                         // The only matrix.begin() in the sketch
+
+    // --- Lease ---
+    bool lease(const void* owner);        // false if someone else holds it
+    bool heldBy(const void* owner) const { return holder == owner; }
+    void reset();                         // Drop the lease and blank the display
+
+    // --- Drawing ---
+    MatrixFrame& back() { return frames[backIndex]; }
+    const MatrixFrame& front() const { return frames[backIndex ^ 1]; }
+    void present(const void* owner);      // Swap back and front (holder only)
+    void show(const void* owner, const MatrixFrame& frame); // Copy into back, then present
+
+    // --- Output ---
+    void update();                        // Push the front frame if it is new
+
+    // micros() when the frame presented as swap number 'swap' (see swaps)
+    // or a later one reached the LEDs; false while it still waits for update()
+    bool shownAt(unsigned long swap, unsigned long& us) const;
+
+    // --- Statistics ---
+    unsigned long swaps;
+    void printStats(Print& out) const;    // Swaps, pushes, and pushes skipped as unchanged
+
+private:
+    ArduinoLEDMatrix matrix;
+    MatrixOutput output;                  // Skips pushes of unchanged frames
+
+    MatrixFrame frames[2];
+    uint8_t backIndex;
+    bool pending;                         // Front frame not yet pushed
+    unsigned long shownSwap;              // swaps at the last update() that pushed
+    unsigned long shownUs;
+    const void* holder;                   // NULL = free
+};
+
+#endif // MATRIX_DISPLAY_H
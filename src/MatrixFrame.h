@@ -0,0 +1,92 @@
+#ifndef MATRIX_FRAME_H
+#define MATRIX_FRAME_H
+
+#include <Arduino.h>
+#include "Arduino_LED_Matrix.h"
+
+// --- Packed 12x8 LED Matrix Frame ---
+// 96 pixels in three 32-bit words, row-major, MSB first: the native format
+// of ArduinoLEDMatrix::loadFrame(). 12 bytes instead of a 96-byte bitmap.
+class MatrixFrame {
+public:
+    static const int WIDTH = 12;
+    static const int HEIGHT = 8;
+
+    uint32_t words[3];
+
+    constexpr MatrixFrame() : words{ 0, 0, 0 } {}
+    constexpr MatrixFrame(uint32_t w0, uint32_t w1, uint32_t w2) : words{ w0, w1, w2 } {}
+
+    // --- Pixels ---
+    void clear() { words[0] = words[1] = words[2] = 0; }
+
+    void set(int x, int y) {
+        if (inside(x, y)) words[index(x, y) >> 5] |= mask(x, y);
+    }
+    void reset(int x, int y) {
+        if (inside(x, y)) words[index(x, y) >> 5] &= ~mask(x, y);
+    }
+    bool get(int x, int y) const {
+        return inside(x, y) && (words[index(x, y) >> 5] & mask(x, y)) != 0;
+    }
+
+    // --- Whole-Frame Operations ---
+    void blit(const MatrixFrame& src) {     // OR another frame on top
+        words[0] |= src.words[0];
+        words[1] |= src.words[1];
+        words[2] |= src.words[2];
+    }
+
+    void erase(const MatrixFrame& src) {    // Clear every pixel lit in another frame
+        words[0] &= ~src.words[0];
+        words[1] &= ~src.words[1];
+        words[2] &= ~src.words[2];
+    }
+
+    int count() const {                     // Pixels lit
+        return __builtin_popcount(words[0]) + __builtin_popcount(words[1]) + __builtin_popcount(words[2]);
+    }
+
+    bool operator==(const MatrixFrame& other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2];
+    }
+    bool operator!=(const MatrixFrame& other) const { return !(*this == other); }
+
+private:
+    static bool inside(int x, int y) { return x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT; }
+    static int index(int x, int y) { return y * WIDTH + x; }
+    static uint32_t mask(int x, int y) { return 0x80000000UL >> (index(x, y) & 31); }
+};
+
+// --- Change-Detecting Matrix Output ---
+// Remembers the last frame pushed and skips loadFrame() when nothing moved.
+// The 96-bit frame is its own hash: three word compares, no collisions.
+class MatrixOutput {
+public:
+    MatrixOutput(ArduinoLEDMatrix& matrixRef) : matrix(matrixRef), valid(false), pushes(0), skipped(0) {}
+
+    void push(const MatrixFrame& frame) {
+        if (valid && frame == shown) {
+            skipped++;
+            return;
+        }
+        matrix.loadFrame(frame.words);
+        shown = frame;
+        valid = true;
+        pushes++;
+    }
+
+    void invalidate() { valid = false; }  // Force the next push
+
+    unsigned long pushCount() const { return pushes; }
+    unsigned long skipCount() const { return skipped; }
+
+private:
+    ArduinoLEDMatrix& matrix;
+    MatrixFrame shown;
+    bool valid;
+    unsigned long pushes;
+    unsigned long skipped;
+};
+
+#endif // MATRIX_FRAME_H
@@ -0,0 +1,39 @@
+#include "MemoryStats.h"
+#include <malloc.h>
+
+#if !defined(__GLIBC__)
+extern "C" char* sbrk(int incr);
+#endif
+
+unsigned long MemoryStats::heapArena = 0;
+unsigned long MemoryStats::heapInUse = 0;
+unsigned long MemoryStats::minFreeRam = 0;
+
+void MemoryStats::sample() {
+#if defined(__GLIBC__)
+    // Host build: glibc counters, which include the simulator's own
+    // allocations; the String counter in the host report is the real check
+    struct mallinfo2 info = mallinfo2();
+    heapArena = info.arena;
+    heapInUse = info.uordblks;
+#else
+    struct mallinfo info = mallinfo();
+    heapArena = info.arena;
+    heapInUse = info.uordblks;
+
+    // Gap between the top of the heap and the current stack pointer
+    char stackMarker;
+    unsigned long freeRam = (unsigned long)(&stackMarker - sbrk(0));
+    if (minFreeRam == 0 || freeRam < minFreeRam) minFreeRam = freeRam;
+#endif
+}
+
+void MemoryStats::print(Print& out) {
+    out.print(F("heap arena "));
+    out.print(heapArena);
+    out.print(F(" B, in use "));
+    out.print(heapInUse);
+    out.print(F(" B, min free RAM "));
+    out.print(minFreeRam);
+    out.println(F(" B"));
+}
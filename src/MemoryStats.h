@@ -0,0 +1,19 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <Arduino.h>
+
+// --- RAM / Heap Report ---
+// The heap arena only ever grows, so its size is the heap high-water mark:
+// if it stays flat after boot, nothing on the frame path allocates.
+class MemoryStats {
+public:
+    static void sample();           // Cheap enough for a slow periodic task
+    static void print(Print& out);
+
+    static unsigned long heapArena;     // Bytes claimed from the system (high-water)
+    static unsigned long heapInUse;     // Bytes currently allocated
+    static unsigned long minFreeRam;    // Smallest heap-to-stack gap seen (0 = unknown)
+};
+
+#endif // MEMORY_STATS_H
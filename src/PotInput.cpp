@@ -0,0 +1,106 @@
+#include "PotInput.h"
+
+// Most pots stop a few counts short of either rail
+static const int defaultCalLow = 8;
+static const int defaultCalHigh = 1015;
+
+// --- Constructor ---
+PotInput::PotInput(int potPin)
+    : samples(0), pin(potPin), timerRunning(false), pollUs(0), ringHead(0), iirQ4(0),
+      published(0), calLow(defaultCalLow), calHigh(defaultCalHigh),
+      sweeping(false), seenLow(0), seenHigh(0) {}
+
+bool PotInput::begin() {
+    // Seed every stage with one reading, so the first value() is already right
+    uint16_t first = analogRead(pin);
+    for (uint8_t i = 0; i < MEDIAN_TAPS; i++) ring[i] = first;
+    iirQ4 = first << 4;
+    published = first;
+    pollUs = micros();
+
+    uint8_t type;
+    int8_t channel = FspTimer::get_available_timer(type);
+    if (channel < 0) return false;
+    if (!timer.begin(TIMER_MODE_PERIODIC, type, channel, 1000000.0f / SAMPLE_US, 0.0f, timerCallback, this)) return false;
+    timerRunning = timer.setup_overflow_irq() && timer.open() && timer.start();
+    return timerRunning;
+}
+
+void PotInput::update() {
+    if (timerRunning) return;
+    if ((long)(micros() - pollUs) < 0) return;
+    pollUs += SAMPLE_US;
+    sample();
+}
+
+void PotInput::timerCallback(timer_callback_args_t* args) {
+    static_cast<PotInput*>(const_cast<void*>(args->p_context))->sample();
+}
+
+// --- Filter Pipeline ---
+
+void PotInput::sample() {
+    ring[ringHead] = analogRead(pin);
+    if (++ringHead == MEDIAN_TAPS) ringHead = 0;
+    samples++;
+
+    // Q4 keeps the fraction a plain shift would drop, so the output settles
+    // on the input instead of stalling 2^IIR_SHIFT counts short of it
+    int delta = ((int)median() << 4) - (int)iirQ4;
+    iirQ4 += delta >> IIR_SHIFT;
+    int filtered = (iirQ4 + 8) >> 4;
+
+    if (abs(filtered - (int)published) > HYSTERESIS) published = filtered;
+
+    if (sweeping) {
+        if (published < seenLow) seenLow = published;
+        if (published > seenHigh) seenHigh = published;
+    }
+}
+
+// Insertion sort on a copy: five values, no allocation
+uint16_t PotInput::median() const {
+    uint16_t sorted[MEDIAN_TAPS];
+    for (uint8_t i = 0; i < MEDIAN_TAPS; i++) {
+        uint16_t v = ring[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    return sorted[MEDIAN_TAPS / 2];
+}
+
+// --- Readings ---
+
+int PotInput::value() const {
+    long v = ((long)published - calLow) * FULL_SCALE / (calHigh - calLow);
+    if (v < 0) return 0;
+    if (v > FULL_SCALE) return FULL_SCALE;
+    return (int)v;
+}
+
+void PotInput::calibrate(int low, int high) {
+    if (high - low < 2 * HYSTERESIS) return; // Not a usable range
+    calLow = low;
+    calHigh = high;
+}
+
+void PotInput::startSweep() {
+    noInterrupts();
+    seenLow = seenHigh = published;
+    sweeping = true;
+    interrupts();
+}
+
+bool PotInput::endSweep() {
+    sweeping = false;
+    // The filter's hysteresis can hold either end a few counts short
+    int low = seenLow + HYSTERESIS / 2;
+    int high = seenHigh - HYSTERESIS / 2;
+    if (high - low < (FULL_SCALE + 1) / 4) return false; // Not really swept
+    calibrate(low, high);
+    return true;
+}
@@ -0,0 +1,74 @@
+#ifndef POT_INPUT_H
+#define POT_INPUT_H
+
+#include <Arduino.h>
+#include <FspTimer.h>
+
+// --- Background Potentiometer Sampling ---
+// A hardware timer converts the pot at 500 Hz, off the frame path, and
+// each sample goes through the same small pipeline:
+//
+//   1. median of the last MEDIAN_TAPS samples (drops single-sample spikes)
+//   2. integer IIR, y += (x - y) / 2^IIR_SHIFT, kept in Q4 (~16 ms lag)
+//   3. hysteresis: the published reading only moves once the filtered
+//      value is more than HYSTERESIS counts away from it
+//
+// The result is one volatile word, so value() is a load and a rescale
+// from the calibrated travel (pots rarely reach the rails) to 0..1023.
+// The travel starts at a typical 8..1015 and can be measured with a
+// sweep: between startSweep() and endSweep() the sampler records the
+// lowest and highest readings, and endSweep() adopts them.
+//
+// If no timer is free, begin() returns false and update() takes the
+// samples from the loop instead.
+class PotInput {
+public:
+    static const unsigned long SAMPLE_US = 2000;
+    static const uint8_t MEDIAN_TAPS = 5;       // Odd
+    static const uint8_t IIR_SHIFT = 3;
+    static const uint8_t HYSTERESIS = 4;        // ADC counts
+    static const int FULL_SCALE = 1023;
+
+    PotInput(int pin);
+
+    bool begin();             // Seeds the filter; false = poll update() instead
+    void update();            // Fallback: sample if one is due
+
+    // --- Readings (constant time) ---
+    int value() const;        // Filtered and calibrated, 0..FULL_SCALE
+    int raw() const { return published; } // Filtered, before calibration
+
+    // --- Calibration ---
+    void calibrate(int low, int high); // ADC counts at the two ends of travel
+    void startSweep();        // Record the travel from now on
+    bool endSweep();          // Calibrate to it; false if too short to use
+    int sweepLow() const { return seenLow; }
+    int sweepHigh() const { return seenHigh; }
+
+    // --- Statistics ---
+    unsigned long samples;
+
+private:
+    int pin;
+    FspTimer timer;
+    bool timerRunning;
+    unsigned long pollUs;     // Fallback: next sample due
+
+    // Filter state (touched by the timer callback only)
+    uint16_t ring[MEDIAN_TAPS];
+    uint8_t ringHead;
+    uint16_t iirQ4;           // Filter output << 4
+
+    volatile uint16_t published;
+    int calLow;
+    int calHigh;
+    volatile bool sweeping;
+    volatile uint16_t seenLow;
+    volatile uint16_t seenHigh;
+
+    static void timerCallback(timer_callback_args_t* args);
+    void sample();
+    uint16_t median() const;
+};
+
+#endif // POT_INPUT_H
@@ -0,0 +1,79 @@
+#include "Profiler.h"
+
+Profiler::Stats Profiler::table[Profiler::PROBES];
+uint32_t Profiler::ticksPerUs = 1;
+
+const char* Profiler::names[Profiler::PROBES] = {
+    "loop", "music", "lcd", "matrix"  // Game probes are labelled by the registry
+};
+
+void Profiler::begin() {
+#if defined(DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    ticksPerUs = SystemCoreClock / 1000000UL;
+#endif
+    reset();
+}
+
+void Profiler::reset() {
+    memset(table, 0, sizeof(table));
+}
+
+uint32_t Profiler::now() {
+#if defined(DWT)
+    return DWT->CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+void Profiler::record(uint8_t probe, uint32_t ticks) {
+    if (probe >= PROBES) return;
+    Stats& s = table[probe];
+    if (s.count == 0 || ticks < s.minTicks) s.minTicks = ticks;
+    if (ticks > s.maxTicks) s.maxTicks = ticks;
+    s.sumTicks += ticks;
+    s.count++;
+
+    uint32_t us = ticks / ticksPerUs;
+    uint8_t bucket = 0;
+    for (uint32_t edge = 16; us >= edge && bucket < BUCKETS - 1; edge <<= 2) bucket++;
+    if (s.histogram[bucket] != 0xFFFF) s.histogram[bucket]++;
+}
+
+void Profiler::label(uint8_t probe, const char* name) {
+    if (probe < PROBES) names[probe] = name;
+}
+
+const char* Profiler::name(uint8_t probe) {
+    return (probe < PROBES && names[probe]) ? names[probe] : "";
+}
+
+unsigned long Profiler::toUs(uint32_t ticks) {
+    return ticks / ticksPerUs;
+}
+
+void Profiler::print(Print& out) {
+    out.println(F("probe     runs  min_us  mean_us  max_us  hist <16us, x4 per bucket"));
+    for (uint8_t p = 0; p < PROBES; p++) {
+        const Stats& s = table[p];
+        if (s.count == 0) continue;
+        out.print(name(p));
+        out.print('\t');
+        out.print(s.count);
+        out.print('\t');
+        out.print(toUs(s.minTicks));
+        out.print('\t');
+        out.print((unsigned long)(s.sumTicks / s.count / ticksPerUs));
+        out.print('\t');
+        out.print(toUs(s.maxTicks));
+        out.print('\t');
+        for (uint8_t b = 0; b < BUCKETS; b++) {
+            out.print(' ');
+            out.print(s.histogram[b]);
+        }
+        out.println();
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+// --- Hot-Path Profiling ---
+// PROFILE_SCOPE(probe) times the rest of the enclosing block and folds the
+// duration into that probe's count, min, mean, max and a coarse histogram.
+// On the board the clock is the DWT cycle counter (one load, 20.8 ns at
+// 48 MHz); without one (host build) it is micros().
+//
+// Build with PROFILING 0 and every scope compiles to nothing.
+//
+// Probes may be recorded from interrupt context (the music timer), one
+// writer per probe. Readers take the numbers as they are: a report can
+// mix one sample in with the one before it, which is fine for diagnostics.
+#ifndef PROFILING
+#define PROFILING 1
+#endif
+
+class Profiler {
+public:
+    static const uint8_t MAX_GAMES = 4;
+
+    enum Probe : uint8_t {
+        LOOP,                 // One scheduler pass
+        MUSIC,                // One sequencer tick
+        LCD,                  // One LCD queue pump (bus writes)
+        MATRIX,               // One frame push to the LED driver
+        GAME,                 // One logic tick, per registered game
+        PROBES = GAME + MAX_GAMES
+    };
+
+    // Histogram in powers of four from 16 us: <16, <64, <256 us, <1, <4,
+    // <16, <64 ms and anything longer
+    static const uint8_t BUCKETS = 8;
+
+    struct Stats {
+        unsigned long count;
+        uint32_t minTicks;
+        uint32_t maxTicks;
+        uint64_t sumTicks;
+        uint16_t histogram[BUCKETS]; // Saturating
+    };
+
+    static void begin();      // Starts the cycle counter
+    static void reset();
+
+    static uint32_t now();
+    static void record(uint8_t probe, uint32_t ticks);
+
+    static void label(uint8_t probe, const char* name); // Names the game probes
+    static const char* name(uint8_t probe);
+    static const Stats& stats(uint8_t probe) { return table[probe]; }
+    static unsigned long toUs(uint32_t ticks);
+
+    static void print(Print& out);
+
+private:
+    static Stats table[PROBES];
+    static const char* names[PROBES];
+    static uint32_t ticksPerUs;
+};
+
+// Records on scope exit
+class ProfileScope {
+public:
+    ProfileScope(uint8_t p) : probe(p), start(Profiler::now()) {}
+    ~ProfileScope() { Profiler::record(probe, Profiler::now() - start); }
+
+private:
+    uint8_t probe;
+    uint32_t start;
+};
+
+#if PROFILING
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_SCOPE(probe) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(probe)
+#else
+#define PROFILE_SCOPE(probe) do {} while (0)
+#endif
+
+#endif // PROFILER_H
@@ -1,84 +1,106 @@
 #include "ReactionGame.h"
+#include "TextLayout.h"
+#include "AsciiArt.h"
+#include "Songs.h"
 
-// --- Matrix Bitmaps (0=Off, 1=On) ---
+// --- Matrix Frames (flash) ---
 
 // Frame: "P1" Winner
-uint8_t frame_p1[8][12] = {
-  {0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,1,1,1,0,0,0,0,1,1,0,0},
-  {0,1,0,1,0,0,0,0,0,1,0,0},
-  {0,1,1,1,0,0,0,0,0,1,0,0},
-  {0,1,0,0,0,0,0,0,0,1,0,0},
-  {0,1,0,0,0,0,0,0,0,1,0,0},
-  {0,1,0,0,0,0,0,0,1,1,1,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0}
-};
+static constexpr MatrixFrame frame_p1 = matrixArt(
+    "............",
+    ".###....##..",
+    ".#.#.....#..",
+    ".###.....#..",
+    ".#.......#..",
+    ".#.......#..",
+    ".#......###.",
+    "............");
 
 // Frame: "P2" Winner
-uint8_t frame_p2[8][12] = {
-  {0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,1,1,1,0,0,0,1,1,1,0,0},
-  {0,1,0,1,0,0,0,0,0,1,0,0},
-  {0,1,1,1,0,0,0,1,1,1,0,0},
-  {0,1,0,0,0,0,0,1,0,0,0,0},
-  {0,1,0,0,0,0,0,1,1,1,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0}
-};
+static constexpr MatrixFrame frame_p2 = matrixArt(
+    "............",
+    ".###...###..",
+    ".#.#.....#..",
+    ".###...###..",
+    ".#.....#....",
+    ".#.....###..",
+    "............",
+    "............");
 
 // Frame: "!" (GO Signal)
-uint8_t frame_go[8][12] = {
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0}
-};
+static constexpr MatrixFrame frame_go = matrixArt(
+    ".....##.....",
+    ".....##.....",
+    ".....##.....",
+    ".....##.....",
+    ".....##.....",
+    "............",
+    ".....##.....",
+    ".....##.....");
 
 // Frame: "X" (Foul/False Start)
-uint8_t frame_foul[8][12] = {
-  {0,0,0,0,0,0,0,0,0,0,0,0},
-  {0,0,1,0,0,0,0,0,0,1,0,0},
-  {0,0,0,1,0,0,0,0,1,0,0,0},
-  {0,0,0,0,1,0,0,1,0,0,0,0},
-  {0,0,0,0,0,1,1,0,0,0,0,0},
-  {0,0,0,0,1,0,0,1,0,0,0,0},
-  {0,0,0,1,0,0,0,0,1,0,0,0},
-  {0,0,1,0,0,0,0,0,0,1,0,0}
-};
+static constexpr MatrixFrame frame_foul = matrixArt(
+    "............",
+    "..#......#..",
+    "...#....#...",
+    "....#..#....",
+    ".....##.....",
+    "....#..#....",
+    "...#....#...",
+    "..#......#..");
+
+// --- Custom Chars (flash): player flags ---
+static constexpr Glyph p1Glyph = glyphArt(
+    "#....",
+    "##...",
+    "#.#..",
+    "#....",
+    "#....",
+    "#....",
+    "#....",
+    "#....");
+static constexpr Glyph p2Glyph = glyphArt(
+    "....#",
+    "...##",
+    "..#.#",
+    "....#",
+    "....#",
+    "....#",
+    "....#",
+    "....#");
 
 // --- Constructor ---
-ReactionGame::ReactionGame(LiquidCrystal& lcdRef, int p1Pin, int p2Pin, int selPin)
-    : lcd(lcdRef), player1Pin(p1Pin), player2Pin(p2Pin), selectButtonPin(selPin) {}
+ReactionGame::ReactionGame(const Console& console)
+    : lcd(console.screen), glyphs(console.glyphs), display(console.display), music(console.music), input(console.playerInput),
+      buttons(console.buttons), player1Pin(console.player1Pin), player2Pin(console.player2Pin), selectButtonPin(console.selectPin) {}
 
 // --- Initialization & Control ---
 
-void ReactionGame::begin() {
-    matrix.begin(); 
-}
-
-void ReactionGame::stop() {
-    clearMatrix(); 
-}
-
-void ReactionGame::clearMatrix() {
-    uint8_t frame[8][12];
-    for(int y=0; y<8; y++) for(int x=0; x<12; x++) frame[y][x] = 0;
-    matrix.renderBitmap(frame, 8, 12);
+void ReactionGame::exit() {
+    input.stop();
+    if (glyphsHeld) {
+        glyphs.release(p1Glyph);
+        glyphs.release(p2Glyph);
+        glyphsHeld = false;
+    }
 }
 
-void ReactionGame::setup() {
+void ReactionGame::enter() {
     // Pin Setup
-    pinMode(player1Pin, INPUT);
-    pinMode(player2Pin, INPUT);
-    pinMode(selectButtonPin, INPUT);
+    buttons.add(player1Pin);
+    buttons.add(player2Pin);
+    buttons.add(selectButtonPin);
+
+    // Char Setup (no upload if still resident from last time)
+    if (!glyphsHeld) {
+        p1Code = glyphs.acquire(p1Glyph);
+        p2Code = glyphs.acquire(p2Glyph);
+        glyphsHeld = true;
+    }
 
-    // Char Setup
-    lcd.createChar(0, p1Char); 
-    lcd.createChar(1, p2Char); 
+    // Borrow the LED matrix for the session
+    display.lease(this);
+    input.start();
 
     // Intro UI
     lcd.clear();
@@ -86,78 +108,142 @@ void ReactionGame::setup() {
     lcd.print("REACTION GAME");
     drawInstructions();
     
-    clearMatrix();
-    delay(1500);
+    display.show(this, MatrixFrame());
+    music.play(songMountainKing);
+    events = buttons.reader();
+
+    // Statistics last for the visit, matches until someone takes one
+    stats[0].reset();
+    stats[1].reset();
+    startMatch();
 
-    resetGame();
+    currentState = INTRO;
+    introEnd.start(INTRO_MS);
+}
+
+void ReactionGame::startMatch() {
+    wins[0] = 0;
+    wins[1] = 0;
+    matchOver = false;
 }
 
 void ReactionGame::resetGame() {
     // Randomize Delay
-    randomSeed(analogRead(A1)); 
     goDelayMs = random(2000, 5000);
 
     // Reset State
     winner = 0;
-    reactionTime = 0;
-    currentState = COUNTDOWN;
+    foul = false;
+    reactionUs = 0;
+    awaitingLoser = false;
+    currentState = WAITING;
     startTime = millis();
     lastTime = millis();
-    
-    // Safety Flags
-    buttonsReleased = false;
 
     // Reset UI
     lcd.clear();
-    clearMatrix(); 
+    display.show(this, MatrixFrame()); 
 }
 
 void ReactionGame::drawInstructions() {
     lcd.setCursor(0, 1);
-    lcd.print("<:P1 vs P2:>");
+    lcd.write(p1Code);
+    lcd.print(":P1 vs P2:");
+    lcd.write(p2Code);
 }
 
-// --- Game Logic States ---
-
-void ReactionGame::stateCountdown() {
-    // 1. Safety Phase: Wait for buttons release
-    if (!buttonsReleased) {
-        if (digitalRead(player1Pin) == LOW && digitalRead(player2Pin) == LOW) {
-            buttonsReleased = true;
-            startTime = millis(); // Start timer now
-            lcd.setCursor(0, 0);
-            lcd.print("Ready...      ");
-        } else {
-            if (millis() - lastTime > 500) {
-                lcd.setCursor(0, 0);
-                lcd.print("Release Btn!  ");
-                lastTime = millis();
+// --- Judging ---
+
+// First press recorded since the last call: 1 = P1, 2 = P2, 3 = both in
+// the same instant (a true tie), 0 = none yet. Releases are skipped.
+int ReactionGame::firstPress(unsigned long& timeUs) {
+    InputCapture::Edge edge;
+    int who = 0;
+    while (input.peek(edge)) {
+        if (edge.pressed) {
+            if (who == 0) {
+                who = edge.channel + 1;
+                timeUs = edge.timeUs;
+            } else if (edge.timeUs == timeUs && edge.channel + 1 != who) {
+                who = 3;
+            } else {
+                break; // Later press: left queued for timeLoser()
             }
         }
-        return; 
+        input.pop(edge);
     }
+    return who;
+}
 
-    // 2. Gameplay Phase
-    unsigned long elapsed = millis() - startTime;
+void ReactionGame::finish(int newWinner, bool byFoul) {
+    winner = newWinner;
+    foul = byFoul;
+    if (byFoul) {
+        display.show(this, frame_foul);
+        music.playEffect(sfxFoul);
+    } else {
+        display.show(this, winner == 1 ? frame_p1 : winner == 2 ? frame_p2 : frame_go);
+        music.playEffect(sfxWin);
+    }
 
-    // Check False Start (P1)
-    if (digitalRead(player1Pin) == HIGH) {
-        winner = 2; // P2 Wins
-        reactionTime = 0; 
-        matrix.renderBitmap(frame_foul, 8, 12); 
-        
-        canRestart = false; 
-        currentState = FINISHED;
+    // Score the match; ties and double fouls are replayed
+    if (winner == 1 || winner == 2) {
+        wins[winner - 1]++;
+        matchOver = wins[winner - 1] > MATCH_ROUNDS / 2;
+    }
+
+    events.skip(); // Anything pressed so far belongs to this round
+    finishedAt = millis();
+    closedAt = finishedAt;
+    page = 0;
+    pageShownAt = finishedAt - PAGE_MS; // First page right away
+    currentState = FINISHED;
+}
+
+// The loser's press, if it comes soon enough, still counts for their stats
+void ReactionGame::timeLoser() {
+    InputCapture::Edge edge;
+    while (input.pop(edge)) {
+        if (edge.pressed && edge.channel + 1 != winner) {
+            stats[edge.channel].add(edge.timeUs - litUs);
+            awaitingLoser = false;
+            closedAt = millis();
+            return;
+        }
+    }
+    if (millis() - finishedAt > LOSER_WINDOW_MS) {
+        awaitingLoser = false;
+        closedAt = millis();
+    }
+}
+
+// --- Game Logic States ---
+
+// Safety Phase: the countdown only starts with both buttons up
+void ReactionGame::stateWaiting() {
+    if (!buttons.isDown(player1Pin) && !buttons.isDown(player2Pin)) {
+        input.clear(); // Only presses from here on count
+        startTime = millis(); // Start timer now
+        currentState = COUNTDOWN;
+        lcd.setCursor(0, 0);
+        printPadded(lcd, "Ready...", 14);
         return;
     }
-    // Check False Start (P2)
-    if (digitalRead(player2Pin) == HIGH) {
-        winner = 1; // P1 Wins
-        reactionTime = 0; 
-        matrix.renderBitmap(frame_foul, 8, 12); 
-        
-        canRestart = false; 
-        currentState = FINISHED;
+    if (millis() - lastTime > 500) {
+        lcd.setCursor(0, 0);
+        printPadded(lcd, "Release Btn!", 14);
+        lastTime = millis();
+    }
+}
+
+void ReactionGame::stateCountdown() {
+    unsigned long elapsed = millis() - startTime;
+
+    // Check False Start: whoever pressed first fouls (both at once: both do)
+    unsigned long pressUs;
+    int pressed = firstPress(pressUs);
+    if (pressed != 0) {
+        finish(pressed == 1 ? 2 : pressed == 2 ? 1 : 0, true);
         return;
     }
 
@@ -166,7 +252,9 @@ void ReactionGame::stateCountdown() {
         currentState = GO;
         startTime = millis(); 
         lcd.clear();
-        matrix.renderBitmap(frame_go, 8, 12); // Visual GO
+        display.show(this, frame_go); // Visual GO
+        goSwap = display.swaps;       // Reaction time counts from when this lights
+        music.playEffect(sfxGo);
         return;
     }
 
@@ -176,7 +264,6 @@ void ReactionGame::stateCountdown() {
         lcd.setCursor(0, 0);
         lcd.print("Ready...");
 
-        int secondsLeft = (goDelayMs - elapsed) / 1000 + 1;
         lcd.setCursor(0, 1);
         lcd.print("Wait for GO!");
 
@@ -194,93 +281,154 @@ void ReactionGame::stateGo() {
         lastDisplayed = millis();
     }
 
-    // Check P1 Win
-    if (digitalRead(player1Pin) == HIGH) {
-        reactionTime = millis() - startTime;
-        winner = 1;
-        matrix.renderBitmap(frame_p1, 8, 12); 
-        
-        canRestart = false; 
-        currentState = FINISHED;
-        return;
-    }
+    // First recorded press wins, timed from the GO frame reaching the LEDs
+    unsigned long pressUs;
+    int pressed = firstPress(pressUs);
+    if (pressed == 0) return;
 
-    // Check P2 Win
-    if (digitalRead(player2Pin) == HIGH) {
-        reactionTime = millis() - startTime;
-        winner = 2;
-        matrix.renderBitmap(frame_p2, 8, 12); 
-        
-        canRestart = false; 
-        currentState = FINISHED;
+    if (!display.shownAt(goSwap, litUs) || (long)(pressUs - litUs) < 0) {
+        // Pressed before the signal was actually lit
+        finish(pressed == 1 ? 2 : pressed == 2 ? 1 : 0, true);
         return;
     }
+    reactionUs = pressUs - litUs;
+    if (pressed == 3) {
+        stats[0].add(reactionUs);
+        stats[1].add(reactionUs);
+    } else {
+        stats[pressed - 1].add(reactionUs);
+        awaitingLoser = true;
+    }
+    finish(pressed == 3 ? 0 : pressed, false);
 }
 
 void ReactionGame::stateFinished() {
-    static unsigned long lastDisplayed = 0;
-    
-    // --- Restart Safety Logic ---
-    if (!canRestart) {
-        if (digitalRead(selectButtonPin) == LOW) {
-            canRestart = true; // Button released, ready for input
+    // Presses while the loser is still being timed, or already under way
+    // when the round closed, are part of the round (P1 is also Select)
+    bool restart = false;
+    ButtonInput::Event event;
+    while (events.pop(event)) {
+        if (event.pressed(selectButtonPin) && !awaitingLoser && (long)(event.timeMs - closedAt) >= (long)SETTLE_MS) {
+            restart = true;
         }
     }
-    
-    // Check Restart Command
-    if (canRestart && digitalRead(selectButtonPin) == HIGH) {
+    if (awaitingLoser) timeLoser();
+
+    // Check Restart Command: next round, or a new match once one is won
+    if (restart) {
         lcd.clear();
-        lcd.print("Restarting...");
-        delay(500); 
-        resetGame();
+        lcd.print(matchOver ? "New match..." : "Next round...");
+        if (matchOver) startMatch();
+        currentState = INTRO;
+        introEnd.start(TRANSITION_MS);
         return;
     }
 
-    // Toggle UI Info
-    if (millis() - lastDisplayed > 2000) {
-        lcd.clear();
-        
-        // Line 0: Result
-        lcd.setCursor(0, 0);
-        if (reactionTime > 0) {
-            if (winner == 1) lcd.print("P1 Wins! ");
-            else lcd.print("P2 Wins! ");
-            lcd.print(reactionTime);
-            lcd.print("ms");
-        } else {
-            // FIX: Mensagem de falta específica
-            if (winner == 1) {
-                // Vencedor é P1, logo P2 cometeu a falta
-                lcd.print("P2 FOUL! P1 WINS");
+    // Cycle the results pages
+    if (millis() - pageShownAt >= PAGE_MS) {
+        drawPage();
+        page = (page + 1) % PAGES;
+        pageShownAt = millis();
+    }
+}
+
+// --- Results Pages ---
+
+void ReactionGame::drawPage() {
+    lcd.clear();
+    switch (page) {
+        case 0: // Round result and match score
+            drawResult();
+            lcd.setCursor(0, 1);
+            if (matchOver) {
+                lcd.print(wins[0] > wins[1] ? "P1" : "P2");
+                lcd.print(" TAKES IT ");
             } else {
-                // Vencedor é P2, logo P1 cometeu a falta
-                lcd.print("P1 FOUL! P2 WINS");
+                lcd.print("P1 vs P2 ");
             }
-        }
-        
-        // Line 1: Instructions
-        lcd.setCursor(0, 1);
-        static bool toggle = false;
-        toggle = !toggle;
-        
-        if (toggle) {
-            if (!canRestart && winner == 1) { 
+            lcd.print(wins[0]);
+            lcd.print('-');
+            lcd.print(wins[1]);
+            break;
+
+        case 1:
+            drawStats(0);
+            break;
+
+        case 2:
+            drawStats(1);
+            break;
+
+        default: // Instructions
+            lcd.setCursor(0, 0);
+            if (buttons.isDown(selectButtonPin)) {
                 lcd.print("Release Btn P1");
             } else {
-                lcd.print("Select: Replay");
+                lcd.print(matchOver ? "Select: New Game" : "Select: Next");
             }
-        } else {
+            lcd.setCursor(0, 1);
             lcd.print("Exit: Menu");
+            break;
+    }
+}
+
+void ReactionGame::drawResult() {
+    lcd.setCursor(0, 0);
+    if (!foul) {
+        if (winner == 1) lcd.print("P1 Wins! ");
+        else if (winner == 2) lcd.print("P2 Wins! ");
+        else lcd.print("TIE! ");
+        // Milliseconds, with tenths while they fit
+        lcd.print(reactionUs / 1000);
+        if (reactionUs < 1000000UL) {
+            lcd.print('.');
+            lcd.print((reactionUs / 100) % 10);
+        }
+        lcd.print("ms");
+    } else if (winner == 0) {
+        lcd.print("DOUBLE FOUL!");
+    } else {
+        // FIX: Mensagem de falta específica
+        if (winner == 1) {
+            // Vencedor é P1, logo P2 cometeu a falta
+            lcd.print("P2 FOUL! P1 WINS");
+        } else {
+            // Vencedor é P2, logo P1 cometeu a falta
+            lcd.print("P1 FOUL! P2 WINS");
         }
-        
-        lastDisplayed = millis();
     }
 }
 
+// Line 0: best and mean +- deviation, line 1: median and 90th percentile (ms)
+void ReactionGame::drawStats(int player) {
+    const ReactionStats& s = stats[player];
+    lcd.setCursor(0, 0);
+    lcd.print(player == 0 ? "P1" : "P2");
+    if (s.count() == 0) {
+        lcd.print(" no times yet");
+        return;
+    }
+    lcd.print(" b");
+    lcd.print(s.bestUs() / 1000);
+    lcd.print(" ~");
+    lcd.print(s.meanUs() / 1000);
+    if (s.count() > 1) {
+        lcd.print("+-");
+        lcd.print(s.stdDevUs() / 1000);
+    }
+
+    lcd.setCursor(0, 1);
+    lcd.print("p50/90 "); // Fits two 4-digit times in 16 columns
+    lcd.print(s.percentileUs(50) / 1000);
+    lcd.print(' ');
+    lcd.print(s.percentileUs(90) / 1000);
+}
+
 // --- Main Loop ---
-void ReactionGame::run() {
+void ReactionGame::tick() {
     switch (currentState) {
-        case WAITING:   break;
+        case INTRO:     if (introEnd.passed()) resetGame(); break;
+        case WAITING:   stateWaiting();   break;
         case COUNTDOWN: stateCountdown(); break;
         case GO:        stateGo();        break;
         case FINISHED:  stateFinished();  break;
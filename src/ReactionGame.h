@@ -2,15 +2,23 @@
 #define REACTIONGAME_H
 
 #include <Arduino.h>
-#include <LiquidCrystal.h>
-#include "Arduino_LED_Matrix.h" 
+#include "LcdBuffer.h"
+#include "GlyphCache.h"
+#include "MatrixDisplay.h"
+#include "GameMusic.h"
+#include "InputCapture.h"
+#include "ButtonInput.h"
+#include "Game.h"
+#include "Console.h"
+#include "ReactionStats.h"
 
 // --- Class Definition ---
-class ReactionGame {
+class ReactionGame : public Game {
 public:
     // --- Game States ---
     enum GameState {
-        WAITING,
+        INTRO,                 // Intro or transition message, then a round
+        WAITING,               // For both buttons to be up
         COUNTDOWN,
         GO,
         FINISHED
@@ -18,8 +26,13 @@ public:
 
 private:
     // --- Hardware References ---
-    LiquidCrystal& lcd;
-    ArduinoLEDMatrix matrix;
+    LcdBuffer& lcd;
+    GlyphCache& glyphs;
+    MatrixDisplay& display;
+    GameMusic& music;
+    InputCapture& input;       // Timestamped P1/P2 edges, for judging
+    ButtonInput& buttons;      // Debounced levels and Select presses
+    ButtonInput::Reader events;
 
     // --- Pin Definitions ---
     const int player1Pin;
@@ -27,40 +40,72 @@ private:
     int selectButtonPin; 
 
     // --- State Variables ---
-    GameState currentState = WAITING;
+    GameState currentState = INTRO;
+    Deadline introEnd;
+    static const unsigned long INTRO_MS = 1500;
+    static const unsigned long TRANSITION_MS = 500;
     unsigned long lastTime = 0;
     unsigned long startTime = 0;
     long goDelayMs = 0; 
 
-    // --- Safety Flags ---
-    bool canRestart;       // Prevent immediate restart if button held
-    bool buttonsReleased;  // Prevent false start on next round
+    // --- GO Signal ---
+    unsigned long goSwap = 0;  // Matrix swap that shows the GO frame
 
     // --- Scoring & Results ---
     int winner = 0;        // 1=P1, 2=P2, 0=Tie/None
-    unsigned long reactionTime = 0;
+    bool foul = false;     // Decided by a false start
+    unsigned long reactionUs = 0; // From the GO frame lighting up
+    unsigned long litUs = 0;      // When the GO frame lit, for the loser's time
 
-    // --- Custom Char Arrays ---
-    byte p1Char[8] = { B10000, B11000, B10100, B10000, B10000, B10000, B10000, B10000 };
-    byte p2Char[8] = { B00001, B00011, B00101, B00001, B00001, B00001, B00001, B00001 };
+    // --- Match (best of MATCH_ROUNDS; ties and double fouls replay) ---
+    static const uint8_t MATCH_ROUNDS = 5;
+    static const unsigned long LOSER_WINDOW_MS = 1500; // Loser's press still timed
+    uint8_t wins[2] = {0, 0};
+    bool matchOver = false;
+    bool awaitingLoser = false;   // Winner pressed, loser's press not yet in
+    unsigned long finishedAt = 0;
+    unsigned long closedAt = 0;   // Loser timed too: presses from here on are new
+    static const unsigned long SETTLE_MS = 100; // Presses this soon after still belong to the round
+
+    // --- Session Statistics (per player, every timed press) ---
+    ReactionStats stats[2];
+
+    // --- Results Pages ---
+    static const uint8_t PAGES = 4;
+    static const unsigned long PAGE_MS = 2000;
+    uint8_t page = 0;
+    unsigned long pageShownAt = 0;
+
+    // --- Custom Chars (codes handed out by the glyph cache) ---
+    bool glyphsHeld = false;
+    uint8_t p1Code = 0;
+    uint8_t p2Code = 0;
 
     // --- Internal Helpers ---
+    void startMatch();
     void resetGame();
+    void stateWaiting();
     void stateCountdown();
     void stateGo();
     void stateFinished();
     void drawInstructions();
-    void clearMatrix();
+    int firstPress(unsigned long& timeUs);
+    void finish(int newWinner, bool byFoul);
+    void timeLoser();
+    void drawPage();
+    void drawResult();
+    void drawStats(int player);
 
 public:
+    static constexpr const char* MENU_NAME = "Reaction Duel";
+
     // --- Constructor ---
-    ReactionGame(LiquidCrystal& lcdRef, int p1Pin, int p2Pin, int selPin);
+    ReactionGame(const Console& console);
 
-    // --- Main Methods ---
-    void begin();         // Hardware initialization
-    void setup();         // Session setup
-    void run();           // Main game loop
-    void stop();          // Cleanup on exit
+    // --- Game ---
+    void enter() override; // Session setup (takes the matrix lease)
+    void tick() override;  // Main game loop
+    void exit() override;  // Cleanup on exit
 };
 
 #endif // REACTIONGAME_H
\ No newline at end of file
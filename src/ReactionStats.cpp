@@ -0,0 +1,62 @@
+#include "ReactionStats.h"
+
+void ReactionStats::reset() {
+    n = 0;
+    best = 0;
+    worst = 0;
+    mean = 0;
+    m2 = 0;
+    memset(histogram, 0, sizeof(histogram));
+}
+
+void ReactionStats::add(unsigned long us) {
+    if (n == 0xFFFF) return; // Saturated
+
+    n++;
+    if (n == 1 || us < best) best = us;
+    if (us > worst) worst = us;
+
+    // Welford: update the mean, then accumulate against old and new mean
+    float delta = (float)us - mean;
+    mean += delta / n;
+    m2 += delta * ((float)us - mean);
+
+    int bucket = (us < FIRST_US) ? 0 : (us - FIRST_US) / BUCKET_US;
+    if (bucket >= BUCKETS) bucket = BUCKETS - 1;
+    histogram[bucket]++;
+}
+
+unsigned long ReactionStats::stdDevUs() const {
+    if (n < 2) return 0;
+    return (unsigned long)sqrtf(m2 / (n - 1)); // Sample standard deviation
+}
+
+unsigned long ReactionStats::percentileUs(uint8_t pct) const {
+    if (n == 0) return 0;
+
+    // Rank of the wanted sample, 1..n
+    uint16_t rank = ((uint32_t)pct * n + 99) / 100;
+    if (rank == 0) rank = 1;
+
+    uint16_t below = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        if (below + histogram[b] < rank) {
+            below += histogram[b];
+            continue;
+        }
+        // Spread the bucket's samples evenly across its range. The last
+        // bucket is open-ended: its samples run from its low edge up to
+        // the worst one, which the top rank lands on exactly.
+        unsigned long low = FIRST_US + b * BUCKET_US;
+        unsigned long us;
+        if (b == BUCKETS - 1 && worst > low) {
+            us = low + (unsigned long)((uint64_t)(worst - low) * (rank - below) / histogram[b]);
+        } else {
+            us = low + (BUCKET_US * (rank - below) - BUCKET_US / 2) / histogram[b];
+        }
+        if (us < best) us = best;
+        if (us > worst) us = worst;
+        return us;
+    }
+    return worst;
+}
@@ -0,0 +1,37 @@
+#ifndef REACTION_STATS_H
+#define REACTION_STATS_H
+
+#include <Arduino.h>
+
+// --- Streaming Reaction-Time Statistics ---
+// Constant memory however many rounds are played: count, best and worst,
+// running mean and variance (Welford's update, numerically stable in single
+// precision), and a fixed-bucket histogram for percentile estimates.
+class ReactionStats {
+public:
+    static const uint8_t BUCKETS = 16;
+    static const unsigned long FIRST_US = 100000;  // Bucket 0 starts here (and takes anything faster)
+    static const unsigned long BUCKET_US = 25000;  // 100..500 ms; the last bucket takes anything slower
+
+    ReactionStats() { reset(); }
+
+    void reset();
+    void add(unsigned long us);
+
+    uint16_t count() const { return n; }
+    unsigned long bestUs() const { return best; }
+    unsigned long worstUs() const { return worst; }
+    unsigned long meanUs() const { return (unsigned long)mean; }
+    unsigned long stdDevUs() const;
+    unsigned long percentileUs(uint8_t pct) const; // Interpolated within its bucket (the last up to worst)
+
+private:
+    uint16_t n;
+    unsigned long best;
+    unsigned long worst;
+    float mean;
+    float m2;                 // Sum of squared deviations from the mean
+    uint16_t histogram[BUCKETS];
+};
+
+#endif // REACTION_STATS_H
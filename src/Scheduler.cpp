@@ -0,0 +1,127 @@
+#include "Scheduler.h"
+
+// --- Constructor ---
+Scheduler::Scheduler() : count(0) {}
+
+// --- Registration ---
+
+int Scheduler::addTask(const char* name, TaskFn fn, unsigned long periodUs, unsigned long deadlineUs) {
+    if (count >= MAX_TASKS) return -1;
+
+    Task& t = tasks[count];
+    t.name = name;
+    t.fn = fn;
+    t.periodUs = periodUs;
+    t.deadlineUs = deadlineUs;
+    t.nextRelease = micros();
+    t.enabled = true;
+
+    clearStats(t);
+    return count++;
+}
+
+int Scheduler::addBackgroundTask(const char* name, TaskFn fn) {
+    return addTask(name, fn, 0, 0);
+}
+
+void Scheduler::start() {
+    unsigned long now = micros();
+    for (int i = 0; i < count; i++) {
+        tasks[i].nextRelease = now;
+    }
+    resetStats();
+}
+
+void Scheduler::setEnabled(int id, bool enabled) {
+    if (id < 0 || id >= count) return;
+    tasks[id].enabled = enabled;
+    // Re-enabled tasks start from "now" rather than bursting to catch up
+    tasks[id].nextRelease = micros();
+}
+
+void Scheduler::resetStats() {
+    for (int i = 0; i < count; i++) {
+        clearStats(tasks[i]);
+    }
+}
+
+void Scheduler::clearStats(Task& t) {
+    t.runs = 0;
+    t.misses = 0;
+    t.skipped = 0;
+    t.lastJitterUs = 0;
+    t.maxJitterUs = 0;
+    t.maxRunUs = 0;
+}
+
+// --- Dispatch ---
+
+void Scheduler::execute(Task& t, unsigned long releaseTime) {
+    unsigned long startTime = micros();
+    t.fn();
+    unsigned long endTime = micros();
+
+    t.runs++;
+    t.lastJitterUs = startTime - releaseTime;
+    if (t.lastJitterUs > t.maxJitterUs) t.maxJitterUs = t.lastJitterUs;
+    if (endTime - startTime > t.maxRunUs) t.maxRunUs = endTime - startTime;
+
+    if (t.periodUs > 0 && endTime - releaseTime > t.deadlineUs) {
+        t.misses++;
+    }
+}
+
+void Scheduler::run() {
+    unsigned long now = micros();
+
+    // 1. Highest-priority due periodic task (one per call, so priorities
+    //    are re-evaluated after every task)
+    for (int i = 0; i < count; i++) {
+        Task& t = tasks[i];
+        if (!t.enabled || t.periodUs == 0) continue;
+        if ((long)(now - t.nextRelease) < 0) continue;
+
+        unsigned long release = t.nextRelease;
+
+        // Overrun: drop whole periods instead of running a burst of catch-ups
+        unsigned long late = now - release;
+        if (late >= t.periodUs) {
+            unsigned long periods = late / t.periodUs;
+            t.skipped += periods;
+            release += periods * t.periodUs;
+        }
+        t.nextRelease = release + t.periodUs;
+
+        execute(t, release);
+        return;
+    }
+
+    // 2. Nothing due: background tasks
+    for (int i = 0; i < count; i++) {
+        Task& t = tasks[i];
+        if (!t.enabled || t.periodUs != 0) continue;
+        execute(t, micros());
+    }
+}
+
+// --- Reporting ---
+
+void Scheduler::printStats(Print& out) const {
+    out.println(F("task      period  runs  miss  skip  jit_max  run_max"));
+    for (int i = 0; i < count; i++) {
+        const Task& t = tasks[i];
+        out.print(t.name);
+        out.print('\t');
+        out.print(t.periodUs);
+        out.print('\t');
+        out.print(t.runs);
+        out.print('\t');
+        out.print(t.misses);
+        out.print('\t');
+        out.print(t.skipped);
+        out.print('\t');
+        out.print(t.maxJitterUs);
+        out.print('\t');
+        out.println(t.maxRunUs);
+    }
+}
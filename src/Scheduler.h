@@ -0,0 +1,58 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// --- Cooperative Fixed-Rate Scheduler ---
+// Tasks are released on a fixed period (in microseconds) and run from loop().
+// Registration order is priority order: when several tasks are due, the one
+// added first runs first. Tasks with period 0 are background tasks and only
+// run when no periodic task is due ("when there is time").
+class Scheduler {
+public:
+    typedef void (*TaskFn)();
+
+    static const int MAX_TASKS = 8;
+
+    struct Task {
+        const char* name;
+        TaskFn fn;
+        unsigned long periodUs;    // 0 = background task
+        unsigned long deadlineUs;  // Relative to release time
+        unsigned long nextRelease;
+        bool enabled;
+
+        // --- Statistics ---
+        unsigned long runs;
+        unsigned long misses;      // Finished after release + deadline
+        unsigned long skipped;     // Whole periods dropped while overrun
+        unsigned long lastJitterUs;
+        unsigned long maxJitterUs; // Start time minus release time
+        unsigned long maxRunUs;
+    };
+
+    Scheduler();
+
+    // Returns the task id, or -1 if the table is full
+    int addTask(const char* name, TaskFn fn, unsigned long periodUs, unsigned long deadlineUs);
+    int addBackgroundTask(const char* name, TaskFn fn);
+
+    void start();                 // Align all releases to "now"
+    void run();                   // Call from loop(), never blocks
+    void setEnabled(int id, bool enabled);
+    void resetStats();
+
+    int taskCount() const { return count; }
+    const Task& task(int id) const { return tasks[id]; }
+
+    void printStats(Print& out) const;
+
+private:
+    Task tasks[MAX_TASKS];
+    int count;
+
+    void execute(Task& t, unsigned long releaseTime);
+    static void clearStats(Task& t);
+};
+
+#endif // SCHEDULER_H
@@ -0,0 +1,170 @@
+#ifndef SONG_FORMAT_H
+#define SONG_FORMAT_H
+
+#include <Arduino.h>
+
+// --- Compact Song Format ---
+// One byte per note, streamed straight from flash by GameMusic:
+//
+//   bits 7..5  length code: 0..5 = 1/32 .. 1/1 note, 6 = dot prefix
+//              (the next note is 1.5x long), 7 = unused
+//   bits 4..0  pitch: 0 = rest, 1..31 = song base note + (pitch - 1)
+//
+// Songs are written as RTTTL-style text and packed at compile time:
+// "<length><note>[#]<octave>[.]" tokens separated by spaces, 'p' for a
+// rest, e.g. "8e5 16d#5 4.c6 2p". Length defaults to 4, octave to 5. A '|'
+// marks the loop point; a song without one plays once. The base note is
+// the lowest pitch used, so a song may span 31 semitones.
+//
+//   static constexpr char odeText[] = "| 4e5 4e5 4f5 4g5 ...";
+//   static constexpr SongData<songSize(odeText)> odeData = compileSong<songSize(odeText)>(odeText);
+//   const Song ode = makeSong("Ode to Joy", odeData, 120);
+
+struct Song {
+    static const uint16_t NO_LOOP = 0xFFFF;
+
+    const char* name;
+    const uint8_t* data;
+    uint16_t length;          // Bytes
+    uint16_t loopFrom;        // Byte offset the song repeats from, or NO_LOOP
+    uint8_t base;             // MIDI note of pitch 1
+    uint8_t tempo;            // Quarter notes per minute
+};
+
+// A short song played over the music; higher priority wins the buzzer
+struct SoundEffect {
+    const Song* song;
+    uint8_t priority;
+};
+
+namespace SongCode {
+    const uint8_t LENGTH_SHIFT = 5;
+    const uint8_t PITCH_MASK = 0x1F;
+    const uint8_t DOT = 6;
+    const uint8_t MAX_PITCH = 31;
+}
+
+template <size_t N>
+struct SongData {
+    uint8_t bytes[N];
+    uint16_t loopFrom;
+    uint8_t base;
+};
+
+// --- Compile-Time Song Compiler ---
+// Malformed text stops compilation with a call to one of these (undefined,
+// not constexpr) functions; the function name is the error message.
+void songErrorBadLength();
+void songErrorBadNote();
+void songErrorRangeOver31Semitones();
+
+namespace SongText {
+    struct Token {
+        const char* next;     // Text after the token
+        bool note;            // false = '|' or end of text
+        bool loopMark;
+        bool dotted;
+        uint8_t lengthCode;
+        int midi;             // -1 = rest
+    };
+
+    constexpr bool isSpace(char c) { return c == ' ' || c == ',' || c == '\n'; }
+
+    constexpr Token read(const char* p) {
+        Token t = { p, false, false, false, 2, -1 };
+        while (isSpace(*p)) p++;
+        t.next = p;
+        if (*p == '\0') return t;
+        if (*p == '|') {
+            t.loopMark = true;
+            t.next = p + 1;
+            return t;
+        }
+
+        int length = 0;
+        while (*p >= '0' && *p <= '9') length = length * 10 + (*p++ - '0');
+        if (length == 0) length = 4;
+        int code = -1;
+        for (int c = 0; c <= 5; c++) {
+            if ((32 >> c) == length) code = c;
+        }
+        if (code < 0) songErrorBadLength();
+        t.lengthCode = code;
+
+        const int semitones[7] = { 9, 11, 0, 2, 4, 5, 7 }; // a..g
+        char name = *p++;
+        bool rest = (name == 'p');
+        int semitone = 0;
+        if (!rest) {
+            if (name < 'a' || name > 'g') songErrorBadNote();
+            semitone = semitones[name - 'a'];
+        }
+        if (*p == '#') {
+            semitone++;
+            p++;
+        }
+        if (*p == '.') {
+            t.dotted = true;
+            p++;
+        }
+        int octave = 5;
+        if (*p >= '0' && *p <= '9') octave = *p++ - '0';
+        if (*p == '.') {
+            t.dotted = true;
+            p++;
+        }
+        if (*p != '\0' && !isSpace(*p) && *p != '|') songErrorBadNote();
+
+        t.note = true;
+        t.midi = rest ? -1 : (octave + 1) * 12 + semitone;
+        t.next = p;
+        return t;
+    }
+
+    constexpr int lowestNote(const char* text) {
+        int low = 127;
+        for (Token t = read(text); t.note || t.loopMark; t = read(t.next)) {
+            if (t.note && t.midi >= 0 && t.midi < low) low = t.midi;
+        }
+        return low;
+    }
+}
+
+// Encoded size of 'text' in bytes (template argument for compileSong)
+constexpr size_t songSize(const char* text) {
+    size_t size = 0;
+    for (SongText::Token t = SongText::read(text); t.note || t.loopMark; t = SongText::read(t.next)) {
+        if (t.note) size += t.dotted ? 2 : 1;
+    }
+    return size;
+}
+
+template <size_t N>
+constexpr SongData<N> compileSong(const char* text) {
+    SongData<N> song = {};
+    song.loopFrom = Song::NO_LOOP;
+    song.base = (uint8_t)SongText::lowestNote(text);
+
+    size_t out = 0;
+    for (SongText::Token t = SongText::read(text); t.note || t.loopMark; t = SongText::read(t.next)) {
+        if (t.loopMark) {
+            song.loopFrom = out;
+            continue;
+        }
+        int pitch = 0;
+        if (t.midi >= 0) {
+            pitch = t.midi - song.base + 1;
+            if (pitch > SongCode::MAX_PITCH) songErrorRangeOver31Semitones();
+        }
+        if (t.dotted) song.bytes[out++] = SongCode::DOT << SongCode::LENGTH_SHIFT;
+        song.bytes[out++] = (t.lengthCode << SongCode::LENGTH_SHIFT) | pitch;
+    }
+    return song;
+}
+
+template <size_t N>
+constexpr Song makeSong(const char* name, const SongData<N>& data, uint8_t tempo) {
+    return Song{ name, data.bytes, (uint16_t)N, data.loopFrom, data.base, tempo };
+}
+
+#endif // SONG_FORMAT_H
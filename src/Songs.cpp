@@ -0,0 +1,109 @@
+#include "Songs.h"
+
+// Packs 'text' into flash at compile time and defines the Song that plays it
+#define SONG(var, title, tempo, text)                                     \
+    static constexpr char var##Text[] = text;                             \
+    static constexpr SongData<songSize(var##Text)> var##Data =            \
+        compileSong<songSize(var##Text)>(var##Text);                      \
+    const Song var = makeSong(title, var##Data, tempo)
+
+// --- Themes ---
+
+// Pacman intro
+// Score available at https://musescore.com/user/85429/scores/107109
+SONG(songPacman, "Pacman", 105,
+    "| 16b4 16b5 16f#5 16d#5 32b5 16f#5. 8d#5 16c5"
+    "  16c6 16g6 16e6 32c6 16g6. 8e6"
+    "  16b4 16b5 16f#5 16d#5 32b5 16f#5. 8d#5 32d#5 32e5 32f5"
+    "  32f5 32f#5 32g5 32g5 32g#5 16a5 8b5");
+
+// Korobeiniki (Russian folk song)
+SONG(songKorobeiniki, "Korobeiniki", 144,
+    "| 4e5 8b4 8c5 4d5 8c5 8b4 4a4 8a4 8c5 4e5 8d5 8c5"
+    "  4b4. 8c5 4d5 4e5 4c5 4a4 2a4");
+
+// Ode to Joy (Beethoven)
+SONG(songOdeToJoy, "Ode to Joy", 120,
+    "| 4e5 4e5 4f5 4g5 4g5 4f5 4e5 4d5 4c5 4c5 4d5 4e5 4e5. 8d5 2d5");
+
+// Twinkle, Twinkle, Little Star
+SONG(songTwinkle, "Twinkle", 100,
+    "| 4c5 4c5 4g5 4g5 4a5 4a5 2g5 4f5 4f5 4e5 4e5 4d5 4d5 2c5");
+
+// Fur Elise (Beethoven)
+SONG(songFurElise, "Fur Elise", 140,
+    "| 8e6 8d#6 8e6 8d#6 8e6 8b5 8d6 8c6 4a5 8p 8c5 8e5 8a5 4b5"
+    "  8p 8e5 8g#5 8b5 4c6 8p");
+
+// In the Hall of the Mountain King (Grieg)
+SONG(songMountainKing, "Mountain King", 160,
+    "| 8a4 8b4 8c5 8d5 8e5 8c5 4e5 8d#5 8b4 4d#5 8d5 8a#4 4d5"
+    "  8a4 8b4 8c5 8d5 8e5 8c5 8e5 8a5 8g5 8e5 8c5 8e5 2g5");
+
+// William Tell Overture, finale (Rossini)
+SONG(songWilliamTell, "William Tell", 150,
+    "| 16e5 16e5 8e5 16e5 16e5 8e5 16e5 16e5 8a5 8b5 8c#6"
+    "  16e5 16e5 8e5 16e5 16e5 8a5 16c#6 16c#6 8b5 8g#5 4e5");
+
+// Galop Infernal, "Can-can" (Offenbach)
+SONG(songCanCan, "Can-can", 160,
+    "| 4c5 8d5 8f5 8e5 8d5 4g5 4g5 8g5 8a5 8e5 8f5 4d5 4d5"
+    "  8d5 8f5 8e5 8d5 8c5 8c6 8b5 8a5 8g5 8f5 8e5 8d5");
+
+// The Entertainer (Joplin)
+SONG(songEntertainer, "Entertainer", 120,
+    "| 8d5 8d#5 8e5 4c6 8e5 4c6 8e5 2c6. 8c6 8d6 8d#6 8e6 8c6 8d6 4e6"
+    "  8b5 4d6 2c6");
+
+// --- Jingles ---
+
+SONG(songVictory, "Victory", 180,
+    "8c5 8e5 8g5 4c6 8g5 2c6");
+
+SONG(songGameOver, "Game Over", 90,
+    "8c5 8g4 8e4 4a4. 8b4 8a4 8g#4 8a#4 8g#4 2g4");
+
+SONG(songCoin, "Coin", 200,
+    "16b5 2e6");
+
+SONG(songPowerUp, "Power Up", 200,
+    "16g4 16b4 16d5 16g5 16b5 16g#4 16c5 16d#5 16g#5 16c6 16a#4 16d5 16f5 16a#5 4d6");
+
+// --- Sound Effects ---
+
+SONG(songWall, "Wall", 240, "32c5");
+SONG(songPaddle, "Paddle", 240, "32g5");
+SONG(songBrick, "Brick", 240, "32e6 32b6");
+SONG(songJump, "Jump", 240, "32c5 32e5 32g5 32c6");
+SONG(songGo, "Go", 240, "8a6");
+SONG(songFoul, "Foul", 240, "16c4 16p 8c4");
+
+const SoundEffect sfxWall = { &songWall, SFX_PRIORITY_LOW };
+const SoundEffect sfxPaddle = { &songPaddle, SFX_PRIORITY_LOW };
+const SoundEffect sfxBrick = { &songBrick, SFX_PRIORITY_NORMAL };
+const SoundEffect sfxBonus = { &songCoin, SFX_PRIORITY_NORMAL };
+const SoundEffect sfxJump = { &songJump, SFX_PRIORITY_NORMAL };
+const SoundEffect sfxGo = { &songGo, SFX_PRIORITY_NORMAL };
+const SoundEffect sfxFoul = { &songFoul, SFX_PRIORITY_HIGH };
+const SoundEffect sfxWin = { &songVictory, SFX_PRIORITY_HIGH };
+const SoundEffect sfxLose = { &songGameOver, SFX_PRIORITY_HIGH };
+
+// --- Library ---
+
+const Song* const songLibrary[] = {
+    &songPacman,
+    &songKorobeiniki,
+    &songOdeToJoy,
+    &songTwinkle,
+    &songFurElise,
+    &songMountainKing,
+    &songWilliamTell,
+    &songCanCan,
+    &songEntertainer,
+    &songVictory,
+    &songGameOver,
+    &songCoin,
+    &songPowerUp
+};
+
+const uint8_t songCount = sizeof(songLibrary) / sizeof(songLibrary[0]);
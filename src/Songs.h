@@ -0,0 +1,45 @@
+#ifndef SONGS_H
+#define SONGS_H
+
+#include "SongFormat.h"
+
+// --- Song Library (flash) ---
+// Game themes loop; jingles and effects play once.
+
+// Themes
+extern const Song songPacman;
+extern const Song songKorobeiniki;
+extern const Song songOdeToJoy;
+extern const Song songTwinkle;
+extern const Song songFurElise;
+extern const Song songMountainKing;
+extern const Song songWilliamTell;
+extern const Song songCanCan;
+extern const Song songEntertainer;
+
+// Jingles
+extern const Song songVictory;
+extern const Song songGameOver;
+extern const Song songCoin;
+extern const Song songPowerUp;
+
+// Sound effects, played over the music (higher priority wins the buzzer)
+const uint8_t SFX_PRIORITY_LOW = 1;      // Bounces: fine to lose one
+const uint8_t SFX_PRIORITY_NORMAL = 2;   // Player actions and scoring
+const uint8_t SFX_PRIORITY_HIGH = 3;     // Round results
+
+extern const SoundEffect sfxWall;
+extern const SoundEffect sfxPaddle;
+extern const SoundEffect sfxBrick;
+extern const SoundEffect sfxBonus;
+extern const SoundEffect sfxJump;
+extern const SoundEffect sfxGo;
+extern const SoundEffect sfxFoul;
+extern const SoundEffect sfxWin;
+extern const SoundEffect sfxLose;
+
+// Every song above (themes and jingles), for menus and reports
+extern const Song* const songLibrary[];
+extern const uint8_t songCount;
+
+#endif // SONGS_H
@@ -0,0 +1,51 @@
+#include "TextLayout.h"
+
+// --- Layout Helpers ---
+
+void printPadded(Print& out, const char* text, int width) {
+    int i = 0;
+    for (; i < width && text[i] != '\0'; i++) out.write((uint8_t)text[i]);
+    for (; i < width; i++) out.write(' ');
+}
+
+void printMarquee(Print& out, const char* text, int width, unsigned int offset, int gap) {
+    int len = strlen(text);
+    if (len <= width) {
+        printPadded(out, text, width);
+        return;
+    }
+
+    // The loop is "text" + gap spaces, so every index is taken modulo that
+    unsigned int period = len + gap;
+    unsigned int index = offset % period;
+    for (int i = 0; i < width; i++) {
+        out.write(index < (unsigned int)len ? (uint8_t)text[index] : ' ');
+        if (++index == period) index = 0;
+    }
+}
+
+void printNumberRight(Print& out, long value, int width) {
+    // Count digits without formatting into a buffer
+    int digits = (value < 0) ? 2 : 1;
+    for (long v = (value < 0) ? -value : value; v >= 10; v /= 10) digits++;
+    for (int i = digits; i < width; i++) out.write(' ');
+    out.print(value);
+}
+
+// --- Marquee ---
+
+Marquee::Marquee(unsigned int step, unsigned int hold)
+    : stepMs(step), holdMs(hold), pos(0), lastStep(0) {}
+
+void Marquee::reset() {
+    pos = 0;
+    lastStep = millis();
+}
+
+void Marquee::update() {
+    unsigned int currentDelay = (pos == 0) ? holdMs : stepMs;
+    if (millis() - lastStep > currentDelay) {
+        pos++;
+        lastStep = millis();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Arduino.h>
+
+// --- Allocation-Free Text Layout ---
+// Everything works on const char* and prints character by character, so no
+// String temporaries (and no heap) are involved in drawing text.
+
+// Prints exactly 'width' characters: clipped, or padded with spaces
+void printPadded(Print& out, const char* text, int width);
+
+// Prints a 'width'-wide window of 'text' looping with a 'gap' of spaces,
+// starting 'offset' characters in. Short texts are printed padded.
+void printMarquee(Print& out, const char* text, int width, unsigned int offset, int gap = 3);
+
+// Prints 'value' right-aligned in a field of 'width' characters
+void printNumberRight(Print& out, long value, int width);
+
+// --- Marquee Timing ---
+// Holds on the first position for 'holdMs', then advances one character
+// every 'stepMs'. The position only ever grows; printMarquee() wraps it.
+class Marquee {
+public:
+    Marquee(unsigned int stepMs, unsigned int holdMs);
+
+    void reset();   // Back to the start, restart the hold time
+    void update();  // Advance according to millis()
+
+    unsigned int position() const { return pos; }
+
+private:
+    const unsigned int stepMs;
+    const unsigned int holdMs;
+    unsigned int pos;
+    unsigned long lastStep;
+};
+
+#endif // TEXT_LAYOUT_H
@@ -1,12 +1,28 @@
 #include <LiquidCrystal.h>
+#include "LcdQueue.h"
+#include "LcdBuffer.h"
+#include "GlyphCache.h"
+#include "MatrixDisplay.h"
 #include "DinoGame.h"
 #include "ReactionGame.h"
 #include "BlockBreaker.h"
 #include "GameMusic.h"
+#include "InputCapture.h"
+#include "PotInput.h"
+#include "ButtonInput.h"
+#include "Scheduler.h"
+#include "TextLayout.h"
+#include "MemoryStats.h"
+#include "GameRegistry.h"
+#include "Profiler.h"
 
 // --- Hardware Setup ---
 const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
 LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+LcdQueue lcdQueue(lcd);    // Non-blocking bus writes, drained by the lcd task
+LcdBuffer screen(lcdQueue); // All drawing goes through the shadow buffer
+GlyphCache glyphs(screen);  // Shared CGRAM slots for every game
+MatrixDisplay matrixDisplay; // The one LED matrix, leased to the active game
 
 // --- Universal Controls ---
 const int potPin = A5;         
@@ -20,241 +36,376 @@ const int player2Pin = 7;
 
 // --- Instantiate Game Objects ---
 
-// DinoGame (Uses LCD + Pin 6)
-DinoGame dinoGame(lcd, selectButtonPin);
+// Buttons, debounced into press/release/hold events (scanned by the input task)
+ButtonInput buttons;
+ButtonInput::Reader menuEvents; // The sketch's own view: menu, About and exit
 
-// ReactionGame (Uses LCD + LED Matrix + Pins 6,7 + Select Button)
-ReactionGame reactionGame(lcd, player1Pin, player2Pin, selectButtonPin);
+// Music System (Uses Pin 9, sequenced from a hardware timer)
+GameMusic gameMusic(buzzerPin);
+
+// Player buttons, edge-timestamped (pin-change IRQs or a 1 kHz timer)
+InputCapture playerButtons(player1Pin, player2Pin);
+
+// Potentiometer, sampled and filtered from a timer (menu + paddle)
+PotInput pot(potPin);
+
+// What every game is built from
+const Console console = {
+    screen, glyphs, matrixDisplay, gameMusic, buttons, pot, playerButtons,
+    selectButtonPin, player1Pin, player2Pin
+};
 
+// --- Games (menu order) ---
+// DinoGame (Uses LCD + Pin 6)
+// ReactionGame (Uses LCD + LED Matrix + Pins 6,7 + Select Button)
 // BlockBreaker (Uses LCD + LED Matrix + Pot A5 + Pin 6)
-BlockBreaker blockBreaker(lcd, potPin, selectButtonPin);
+// Only the one being played is constructed, in the registry's arena.
+GameRegistry<DinoGame, ReactionGame, BlockBreaker> games;
 
-// Music System (Uses Pin 9)
-GameMusic gameMusic(buzzerPin);
+// Task Scheduler (replaces the old delay(30) loop pacing)
+Scheduler scheduler;
+
+const unsigned long inputPeriodUs = 1000;      // 1 kHz button polling
+const unsigned long musicPeriodUs = 5000;      // Polled music, only if no timer is free
+const unsigned long potPeriodUs = PotInput::SAMPLE_US; // Polled pot, likewise
+const unsigned long logicPeriodUs = 30000;     // Fixed game tick
+const unsigned long lcdPeriodUs = 1000;        // LCD queue pump
+const unsigned long lcdBudgetUs = 400;         // ~2 bytes per pump
+const unsigned long statsPeriodUs = 10000000;  // Serial report every 10 s
 
 // --- Application State Management ---
 enum AppState {
+    SPLASH,
     MENU,
-    RUNNING_DINO,
-    RUNNING_REACTION,
-    RUNNING_BLOCKS,
-    ABOUT_SCREEN
+    RUNNING_GAME,
+    ABOUT_SCREEN,
+    POT_CALIBRATION            // Select held through the splash
 };
-AppState currentState = MENU;
+AppState currentState = SPLASH;
+
+const unsigned long splashMs = 1000;
+Deadline splashEnd;
 
 // --- Menu Variables ---
-const char* menuItems[] = {
-    "Dinossaur Jumper",
-    "Reaction Duel",
-    "Brick Breaker",
-    "About/Info"
-};
-const int numMenuItems = sizeof(menuItems) / sizeof(menuItems[0]);
+// One entry per registered game, then About
+const int aboutItem = games.COUNT;
+const int numMenuItems = aboutItem + 1;
 int currentSelection = 0;
 
-const int potTolerance = 10; 
-int lastPotValue = 0;
-
-unsigned long lastDebounceTime = 0;
-const unsigned long debounceDelay = 50; 
-
 // --- Scrolling Variables ---
-unsigned long lastScrollTime = 0;
-int scrollPosition = 0;
 const int scrollSpeed = 400; 
 const int scrollInitialDelay = 1000; 
+Marquee marquee(scrollSpeed, scrollInitialDelay);
 
 // --- Helper Functions ---
 
-void printScrollingText(String text, int limit) {
-    if (text.length() <= limit) {
-        lcd.print(text);
-        for (int i = text.length(); i < limit; i++) lcd.print(" ");
-    } else {
-        String scrollBuffer = text + "   " + text;
-        int offset = scrollPosition % (text.length() + 3);
-        lcd.print(scrollBuffer.substring(offset, offset + limit));
-    }
+const char* menuItem(int index) {
+    return index == aboutItem ? "About/Info" : games.name(index);
 }
 
 void drawMenu() {
-    int potValue = analogRead(potPin);
-
-    // Potentiometer navigation logic
-    if (abs(potValue - lastPotValue) > potTolerance) {
-        int newSelection = map(potValue, 0, 1023, numMenuItems - 1, 0);
+    // Potentiometer navigation logic (already filtered, no threshold needed)
+    int newSelection = map(pot.value(), 0, PotInput::FULL_SCALE + 1, numMenuItems - 1, -1);
 
-        if (newSelection < 0) newSelection = 0;
-        if (newSelection >= numMenuItems) newSelection = numMenuItems - 1;
+    if (newSelection < 0) newSelection = 0;
+    if (newSelection >= numMenuItems) newSelection = numMenuItems - 1;
 
-        if (newSelection != currentSelection) {
-            currentSelection = newSelection;
-            scrollPosition = 0; 
-            lastScrollTime = millis();
-            lcd.clear();
-        }
-        lastPotValue = potValue;
+    if (newSelection != currentSelection) {
+        currentSelection = newSelection;
+        marquee.reset();
+        screen.clear();
     }
     
     // Update scroll timer
-    int currentDelay = (scrollPosition == 0) ? scrollInitialDelay : scrollSpeed;
-    if (millis() - lastScrollTime > currentDelay) {
-        scrollPosition++;
-        lastScrollTime = millis();
-    }
+    marquee.update();
 
     // Draw Menu UI
-    lcd.setCursor(0, 0);
-    lcd.print(">");
-    printScrollingText(menuItems[currentSelection], 15); 
+    screen.setCursor(0, 0);
+    screen.print(">");
+    screen.printStrip(0, 1, 15, menuItem(currentSelection), marquee.position()); 
 
-    lcd.setCursor(0, 1);
+    screen.setCursor(0, 1);
     if (numMenuItems > 1 && currentSelection < numMenuItems - 1) {
-        lcd.print(" "); 
-        String nextItem = menuItems[currentSelection + 1];
-        if (nextItem.length() > 15) {
-            lcd.print(nextItem.substring(0, 15)); 
-        } else {
-            lcd.print(nextItem);
-            for(int i = nextItem.length(); i < 15; i++) lcd.print(" ");
-        }
+        screen.print(" "); 
+        printPadded(screen, menuItem(currentSelection + 1), 15);
     } else {
-        lcd.print("                ");
+        printPadded(screen, "", 16);
     }
 }
 
-void handleSelection() {
-    if (digitalRead(selectButtonPin) == HIGH && (millis() - lastDebounceTime > debounceDelay)) {
-        lastDebounceTime = millis();
-        
-        scrollPosition = 0;
-        lastScrollTime = millis();
-
-        switch (currentSelection) {
-            case 0: // Dinossaur Jumper
-                currentState = RUNNING_DINO;
-                gameMusic.startPacmanIntro();
-                dinoGame.setup();
-                break;
-                
-            case 1: // Reaction Duel
-                currentState = RUNNING_REACTION;
-                gameMusic.startPacmanIntro();
-                reactionGame.setup();
-                break;
-                
-            case 2: // Brick Breaker
-                currentState = RUNNING_BLOCKS;
-                gameMusic.startPacmanIntro();
-                blockBreaker.start(); 
-                break;
-                
-            case 3: // About
-                currentState = ABOUT_SCREEN;
-                lcd.clear();
-                break;
+void handleSelection(const ButtonInput::Event& event) {
+    if (event.pressed(selectButtonPin)) {
+        marquee.reset();
+
+        if (currentSelection == aboutItem) {
+            currentState = ABOUT_SCREEN;
+            screen.clear();
+            return;
         }
+
+        // Intro runs from the game's own ticks
+        currentState = RUNNING_GAME;
+        games.enter(currentSelection, console);
     }
 }
 
+// --- Performance Page (hidden behind About) ---
+// About is the last menu item, so the pot arrives near zero. Turning it past
+// half shows one profiling probe at a time: name, then min/mean/max.
+const unsigned long perfPageMs = 1500;
+uint8_t perfProbe = 0;
+unsigned long perfShownAt = 0;
+bool perfShown = false;
+
+// Compact: 999u, 9.9m, 999m, 12s; returns the characters printed
+size_t printDuration(Print& out, unsigned long us) {
+    if (us < 1000) return out.print(us) + out.print('u');
+    if (us < 10000) return out.print(us / 1000) + out.print('.') + out.print((us / 100) % 10) + out.print('m');
+    if (us < 1000000) return out.print(us / 1000) + out.print('m');
+    return out.print(us / 1000000) + out.print('s');
+}
+
+void drawPerfPage() {
+    if (perfShown && millis() - perfShownAt < perfPageMs) return;
+    if (!perfShown) screen.clear(); // Drop the credits' marquee strips
+
+    // Next probe that has samples
+    for (uint8_t n = 0; n < Profiler::PROBES; n++) {
+        perfProbe = (perfProbe + 1) % Profiler::PROBES;
+        if (Profiler::stats(perfProbe).count > 0) break;
+    }
+    const Profiler::Stats& s = Profiler::stats(perfProbe);
+
+    screen.setCursor(0, 0);
+    printPadded(screen, Profiler::name(perfProbe), 16);
+    screen.setCursor(0, 1);
+    size_t n = 0;
+    if (s.count > 0) {
+        n += printDuration(screen, Profiler::toUs(s.minTicks));
+        n += screen.print('/');
+        n += printDuration(screen, Profiler::toUs(s.sumTicks / s.count));
+        n += screen.print('/');
+        n += printDuration(screen, Profiler::toUs(s.maxTicks));
+    }
+    for (; n < 16; n++) screen.print(' ');
+
+    perfShown = true;
+    perfShownAt = millis();
+}
+
 // --- About Info Screen ---
 void drawAboutScreen() {
+    if (pot.value() > PotInput::FULL_SCALE / 2) {
+        drawPerfPage();
+        return;
+    }
+    if (perfShown) {
+        perfShown = false; // Back to the credits
+        marquee.reset();
+        screen.clear();
+    }
+
     // Update scroll timer
-    int currentDelay = (scrollPosition == 0) ? scrollInitialDelay : scrollSpeed;
-    if (millis() - lastScrollTime > currentDelay) {
-        scrollPosition++;
-        lastScrollTime = millis();
+    marquee.update();
+
+    screen.setCursor(0, 0);
+    screen.printStrip(0, 0, 16, "HOME MADE 'GAMEBOY'", marquee.position()); 
+    screen.setCursor(0, 1);
+    screen.printStrip(1, 0, 16, "By Diegos e Kaique ", marquee.position());
+}
+
+void handleAboutInput(const ButtonInput::Event& event) {
+    if (event.pressed(exitButtonPin) || event.pressed(selectButtonPin)) {
+        currentState = MENU;
+        marquee.reset();
+        screen.clear();
     }
+}
 
-    lcd.setCursor(0, 0);
-    printScrollingText("HOME MADE 'GAMEBOY'", 16); 
-    lcd.setCursor(0, 1);
-    printScrollingText("By Diegos e Kaique ", 16);
+// --- Pot Calibration ---
+// Turn the pot to both ends, then press Select; the measured travel
+// replaces the default one (a sweep that is too short is ignored).
+void drawCalibration() {
+    screen.setCursor(0, 0);
+    printPadded(screen, "Turn pot to ends", 16);
+    screen.setCursor(0, 1);
+    size_t n = screen.print(pot.sweepLow());
+    n += screen.print("..");
+    n += screen.print(pot.sweepHigh());
+    for (; n < 12; n++) screen.print(' ');
+    screen.print(" Sel");
+}
 
-    if ((digitalRead(exitButtonPin) == HIGH || digitalRead(selectButtonPin) == HIGH) && (millis() - lastDebounceTime > debounceDelay)) {
-        lastDebounceTime = millis();
+void handleCalibrationInput(const ButtonInput::Event& event) {
+    if (event.pressed(selectButtonPin)) {
+        pot.endSweep();
         currentState = MENU;
-        scrollPosition = 0; 
-        lastScrollTime = millis();
-        lcd.clear();
+        marquee.reset();
+        screen.clear();
     }
 }
 
-// --- Main Setup ---
-void setup() {
-    lcd.begin(16, 2);
-    
-    // Initialize Input Pins
-    pinMode(selectButtonPin, INPUT);
-    pinMode(exitButtonPin, INPUT);
-    pinMode(player1Pin, INPUT);
-    pinMode(player2Pin, INPUT);
-    pinMode(buzzerPin, OUTPUT);
+// --- Universal Exit (Pin 8) ---
+void handleGameExit(const ButtonInput::Event& event) {
+    if (event.pressed(exitButtonPin)) {
+        games.exit(); // Also frees the game's RAM
+        matrixDisplay.reset(); // Blank the matrix and take it back
+        
+        gameMusic.stopMusic(); // Stop music when exiting games
+        currentState = MENU;
+        marquee.reset();
+        screen.clear();
+    }
+}
 
-    blockBreaker.begin();
-    reactionGame.begin();
+// --- Scheduler Tasks ---
 
-    lastPotValue = analogRead(potPin);
+// Input (1 kHz): scan the buttons, then menu selection and exit
+void inputTask() {
+    buttons.scan();
 
-    // Intro Screen
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print("Arduino R4 WiFi");
-    lcd.setCursor(0, 1);
-    lcd.print("GAMEBOI CASERO");
-    delay(1000);
-    lcd.clear();
+    ButtonInput::Event event;
+    while (menuEvents.pop(event)) {
+        switch (currentState) {
+            case SPLASH:
+                break;
+
+            case MENU:
+                handleSelection(event);
+                break;
+
+            case RUNNING_GAME:
+                handleGameExit(event);
+                break;
+
+            case ABOUT_SCREEN:
+                handleAboutInput(event);
+                break;
+
+            case POT_CALIBRATION:
+                handleCalibrationInput(event);
+                break;
+        }
+    }
 }
 
-// --- Main Loop ---
-void loop() {
-    switch (currentState) {
-        case MENU:
-            drawMenu();
-            handleSelection();
-            break;
+// Music fallback: advance playback when the sequencer has no timer
+void musicTask() {
+    gameMusic.update();
+}
 
-        case RUNNING_DINO:
-        case RUNNING_REACTION:
-        case RUNNING_BLOCKS: 
-            // Universal Exit (Pin 8)
-            if (digitalRead(exitButtonPin) == HIGH && (millis() - lastDebounceTime > debounceDelay)) {
-                lastDebounceTime = millis();
-                
-                if (currentState == RUNNING_BLOCKS) {
-                    blockBreaker.stop();
-                }
-                if (currentState == RUNNING_REACTION) {
-                    reactionGame.stop();
+// Pot fallback: take samples when the pot has no timer
+void potTask() {
+    pot.update();
+}
+
+// Game logic: one fixed tick of the active screen
+void logicTask() {
+    switch (currentState) {
+        case SPLASH:
+            if (splashEnd.passed()) {
+                screen.clear();
+                if (buttons.isDown(selectButtonPin)) {
+                    pot.startSweep();
+                    currentState = POT_CALIBRATION;
+                } else {
+                    currentState = MENU;
                 }
-                
-                gameMusic.stopMusic(); // Stop music when exiting games
-                currentState = MENU;
-                scrollPosition = 0; 
-                lastScrollTime = millis();
-                lcd.clear();
-                break; 
             }
+            break;
 
-            // Update music playback
-            gameMusic.update();
+        case MENU:
+            drawMenu();
+            break;
 
-            // Game Logic Dispatch
-            if (currentState == RUNNING_DINO) {
-                dinoGame.run();
-            } 
-            else if (currentState == RUNNING_REACTION) {
-                reactionGame.run();
-            }
-            else if (currentState == RUNNING_BLOCKS) {
-                blockBreaker.run();
-            }
+        case RUNNING_GAME:
+            games.tick();
             break;
 
         case ABOUT_SCREEN:
             drawAboutScreen();
             break;
+
+        case POT_CALIBRATION:
+            drawCalibration();
+            break;
+    }
+}
+
+// LCD: drain a few queued bytes per tick
+void lcdTask() {
+    lcdQueue.pump(lcdBudgetUs);
+}
+
+// Render (background): queue changed LCD cells and hand the last
+// presented matrix frame to the driver when nothing else is due
+void renderTask() {
+    screen.flush();
+    matrixDisplay.update();
+}
+
+// Frame pacing, service counters and memory report (only when a Serial monitor is attached)
+void statsTask() {
+    MemoryStats::sample();
+    if (Serial) {
+        scheduler.printStats(Serial);
+        gameMusic.printStats(Serial);
+        screen.printStats(Serial);
+        lcdQueue.printStats(Serial);
+        glyphs.printStats(Serial);
+        playerButtons.printStats(Serial);
+        matrixDisplay.printStats(Serial);
+        MemoryStats::print(Serial);
+        Profiler::print(Serial);
     }
+}
 
-    delay(30); // Loop pacing
-}
\ No newline at end of file
+// --- Main Setup ---
+void setup() {
+    lcd.begin(16, 2);
+    screen.begin();
+    
+    // Initialize Input Pins
+    buttons.add(selectButtonPin);
+    buttons.add(exitButtonPin);
+    buttons.add(player1Pin);
+    buttons.add(player2Pin);
+    menuEvents = buttons.reader();
+    pinMode(buzzerPin, OUTPUT);
+
+    // Seed once, before the pot sampler starts using the ADC
+    randomSeed(analogRead(A1));
+
+    matrixDisplay.begin();
+    playerButtons.begin();
+
+    // Intro Screen
+    screen.clear();
+    screen.setCursor(0, 0);
+    screen.print("Arduino R4 WiFi");
+    screen.setCursor(0, 1);
+    screen.print("GAMEBOI CASERO");
+    splashEnd.start(splashMs); // Left from the logic task
+
+    // Task Registration (registration order = priority)
+    Serial.begin(115200);
+    Profiler::begin();
+    scheduler.addTask("input", inputTask, inputPeriodUs, inputPeriodUs);
+    if (!gameMusic.begin()) {
+        scheduler.addTask("music", musicTask, musicPeriodUs, musicPeriodUs);
+    }
+    if (!pot.begin()) {
+        scheduler.addTask("pot", potTask, potPeriodUs, potPeriodUs);
+    }
+    scheduler.addTask("logic", logicTask, logicPeriodUs, logicPeriodUs);
+    scheduler.addTask("lcd", lcdTask, lcdPeriodUs, lcdPeriodUs);
+    scheduler.addTask("stats", statsTask, statsPeriodUs, statsPeriodUs);
+    scheduler.addBackgroundTask("render", renderTask);
+    scheduler.start();
+}
+
+// --- Main Loop ---
+void loop() {
+    PROFILE_SCOPE(Profiler::LOOP);
+    scheduler.run();
+}